@@ -0,0 +1,187 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/common/lock_free_task_runner.h"
+
+#include "base/logging.h"
+#include "base/message_loop/message_loop.h"
+#include "base/trace_event/trace_event.h"
+#include "mojo/common/message_pump_mojo.h"
+
+namespace mojo {
+namespace common {
+
+LockFreeTaskRunner::LockFreeTaskRunner()
+    : head_(reinterpret_cast<base::subtle::AtomicWord>(&stub_)),
+      tail_(&stub_),
+      wakeup_pending_(0),
+      unbound_(0),
+      pump_(nullptr) {
+}
+
+LockFreeTaskRunner::~LockFreeTaskRunner() {
+  // Nobody can post anymore, so a partially linked node is impossible here.
+  bool retry = false;
+  while (Node* node = Pop(&retry))
+    delete node;
+  DCHECK(!retry);
+}
+
+void LockFreeTaskRunner::BindToPump(MessagePumpMojo* pump) {
+  base::AutoLock lock(pump_lock_);
+  DCHECK(!pump_);
+  DCHECK(!base::subtle::NoBarrier_Load(&unbound_));
+  pump_ = pump;
+  // Tasks posted before now could not wake the pump up.
+  if (base::subtle::NoBarrier_Load(&wakeup_pending_))
+    pump_->ScheduleWork();
+}
+
+void LockFreeTaskRunner::UnbindFromPump() {
+  {
+    base::AutoLock lock(pump_lock_);
+    DCHECK(pump_);
+    pump_ = nullptr;
+    base::subtle::Release_Store(&unbound_, 1);
+  }
+
+  // A post racing with this may still push a node after the queue is drained
+  // here. It never runs, and is deleted with the runner.
+  bool retry = false;
+  while (Node* node = Pop(&retry))
+    delete node;
+}
+
+void LockFreeTaskRunner::SetDelayedTaskRunner(
+    scoped_refptr<base::SingleThreadTaskRunner> delayed_task_runner) {
+  DCHECK(!delayed_task_runner_);
+  delayed_task_runner_ = delayed_task_runner;
+}
+
+bool LockFreeTaskRunner::PostDelayedTask(
+    const tracked_objects::Location& from_here,
+    const base::Closure& task,
+    base::TimeDelta delay) {
+  if (delay > base::TimeDelta())
+    return delayed_task_runner_->PostDelayedTask(from_here, task, delay);
+  if (base::subtle::Acquire_Load(&unbound_))
+    return false;
+
+  Node* node = new Node;
+  node->from_here = from_here;
+  node->task = task;
+  Push(node);
+
+  // Pairs with the barrier in RunPendingTasks(): either the pump sees our node
+  // while draining, or we see |wakeup_pending_| cleared and wake it up.
+  base::subtle::MemoryBarrier();
+  if (!base::subtle::NoBarrier_AtomicExchange(&wakeup_pending_, 1)) {
+    base::AutoLock lock(pump_lock_);
+    // If the pump isn't bound yet, BindToPump() wakes it up for our node. If
+    // it is gone, our node is never run.
+    if (!pump_)
+      return !base::subtle::NoBarrier_Load(&unbound_);
+    pump_->ScheduleWork();
+  }
+  return true;
+}
+
+bool LockFreeTaskRunner::PostNonNestableDelayedTask(
+    const tracked_objects::Location& from_here,
+    const base::Closure& task,
+    base::TimeDelta delay) {
+  return delayed_task_runner_->PostNonNestableDelayedTask(from_here, task,
+                                                          delay);
+}
+
+bool LockFreeTaskRunner::RunsTasksOnCurrentThread() const {
+  return delayed_task_runner_->RunsTasksOnCurrentThread();
+}
+
+bool LockFreeTaskRunner::RunPendingTasks(size_t max_tasks) {
+  DCHECK(RunsTasksOnCurrentThread());
+
+  // Clear the flag before looking at the queue so that a post racing with this
+  // drain requests another wakeup instead of being missed.
+  base::subtle::NoBarrier_Store(&wakeup_pending_, 0);
+  base::subtle::MemoryBarrier();
+
+  // As MessageLoop does for its own tasks, keep a nested loop started by one
+  // of these tasks from running further tasks unless it opts in.
+  base::MessageLoop* message_loop = base::MessageLoop::current();
+  const bool nestable_tasks_allowed =
+      message_loop && message_loop->NestableTasksAllowed();
+
+  bool retry = false;
+  for (size_t i = 0; i < max_tasks; ++i) {
+    Node* node = Pop(&retry);
+    if (!node)
+      return retry;
+
+    TRACE_EVENT2("toplevel", "LockFreeTaskRunner::RunTask", "src_file",
+                 node->from_here.file_name(), "src_func",
+                 node->from_here.function_name());
+    if (message_loop)
+      message_loop->SetNestableTasksAllowed(false);
+    pump_->WillSignalHandler();
+    node->task.Run();
+    pump_->DidSignalHandler();
+    if (message_loop)
+      message_loop->SetNestableTasksAllowed(nestable_tasks_allowed);
+    delete node;
+  }
+  return true;
+}
+
+// This is Dmitry Vyukov's intrusive MPSC queue. A push is one atomic exchange
+// on |head_| followed by linking the previous head to the new node.
+void LockFreeTaskRunner::Push(Node* node) {
+  base::subtle::NoBarrier_Store(&node->next, 0);
+  // Make the node's contents visible before it can be reached from |head_|.
+  base::subtle::MemoryBarrier();
+  Node* prev = reinterpret_cast<Node*>(base::subtle::NoBarrier_AtomicExchange(
+      &head_, reinterpret_cast<base::subtle::AtomicWord>(node)));
+  base::subtle::Release_Store(&prev->next,
+                              reinterpret_cast<base::subtle::AtomicWord>(node));
+}
+
+LockFreeTaskRunner::Node* LockFreeTaskRunner::Pop(bool* retry) {
+  Node* tail = tail_;
+  Node* next =
+      reinterpret_cast<Node*>(base::subtle::Acquire_Load(&tail->next));
+
+  if (tail == &stub_) {
+    if (!next)
+      return nullptr;
+    tail_ = next;
+    tail = next;
+    next = reinterpret_cast<Node*>(base::subtle::Acquire_Load(&next->next));
+  }
+
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+
+  Node* head = reinterpret_cast<Node*>(base::subtle::Acquire_Load(&head_));
+  if (tail != head) {
+    // A producer has swapped |head_| but not linked its node yet.
+    *retry = true;
+    return nullptr;
+  }
+
+  // |tail| is the last node. Push the stub behind it so it can be detached.
+  Push(&stub_);
+  next = reinterpret_cast<Node*>(base::subtle::Acquire_Load(&tail->next));
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+
+  *retry = true;
+  return nullptr;
+}
+
+}  // namespace common
+}  // namespace mojo
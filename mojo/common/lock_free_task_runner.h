@@ -0,0 +1,115 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_COMMON_LOCK_FREE_TASK_RUNNER_H_
+#define MOJO_COMMON_LOCK_FREE_TASK_RUNNER_H_
+
+#include "base/atomicops.h"
+#include "base/callback.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/single_thread_task_runner.h"
+#include "base/synchronization/lock.h"
+
+namespace mojo {
+namespace common {
+
+class MessagePumpMojo;
+
+// A SingleThreadTaskRunner for a thread running a MessagePumpMojo that does
+// not take a lock to post a task. Immediate tasks are pushed onto an intrusive
+// multi-producer/single-consumer queue which the pump drains between waits.
+// The pump is only woken (which does take a lock) when the queue goes from
+// empty to non-empty, so a burst of posts from other threads costs one wakeup.
+//
+// Tasks posted through a LockFreeTaskRunner run in the order they were posted,
+// as with MessageLoop. Delayed and non-nestable tasks are forwarded to the
+// MessageLoop's task runner. Tasks in the two queues are not ordered against
+// each other: a task posted to the MessageLoop, or forwarded to it, may run
+// before or after an earlier LockFreeTaskRunner task. Callers that need that
+// ordering must post both tasks to the same runner.
+//
+// Like the MessageLoop's own nestable tasks, these only run in a nested loop
+// if the MessageLoop allows nestable tasks there.
+//
+// Tasks may be posted before the pump is bound; they run once it is.
+class LockFreeTaskRunner : public base::SingleThreadTaskRunner {
+ public:
+  LockFreeTaskRunner();
+
+  // Called by MessagePumpMojo::SetTaskRunner() on the pump's thread.
+  void BindToPump(MessagePumpMojo* pump);
+
+  // Called by ~MessagePumpMojo() on the pump's thread. Queued tasks are
+  // deleted without running, and later posts return false, as they do for a
+  // MessageLoop's task runner once the loop is gone.
+  void UnbindFromPump();
+
+  // Sets the task runner that receives delayed and non-nestable tasks. This
+  // must be the task runner of the MessageLoop that owns the pump, and must be
+  // set before any task is posted.
+  void SetDelayedTaskRunner(
+      scoped_refptr<base::SingleThreadTaskRunner> delayed_task_runner);
+
+  // Runs at most |max_tasks| queued tasks. Returns true if more tasks may be
+  // waiting. Must be called on the pump's thread.
+  bool RunPendingTasks(size_t max_tasks);
+
+  // base::SingleThreadTaskRunner implementation:
+  bool PostDelayedTask(const tracked_objects::Location& from_here,
+                       const base::Closure& task,
+                       base::TimeDelta delay) override;
+  bool PostNonNestableDelayedTask(const tracked_objects::Location& from_here,
+                                  const base::Closure& task,
+                                  base::TimeDelta delay) override;
+  bool RunsTasksOnCurrentThread() const override;
+
+ private:
+  struct Node {
+    Node() : next(0) {}
+
+    // Really a Node*.
+    base::subtle::AtomicWord next;
+    tracked_objects::Location from_here;
+    base::Closure task;
+  };
+
+  ~LockFreeTaskRunner() override;
+
+  void Push(Node* node);
+
+  // Returns the oldest node, or null if the queue is empty or a producer is
+  // midway through a push. In the latter case |*retry| is set to true.
+  Node* Pop(bool* retry);
+
+  // Producers only touch |head_|, the consumer only touches |tail_|. |stub_|
+  // keeps the list non-empty so that neither end ever needs a lock.
+  base::subtle::AtomicWord head_;
+  Node* tail_;
+  Node stub_;
+
+  // Non-zero while a wakeup has been requested and the pump has not started
+  // draining the queue yet.
+  base::subtle::Atomic32 wakeup_pending_;
+
+  // Set once the pump is destroyed. Checked before pushing so that posts
+  // after that fail without taking |pump_lock_|. Only set with |pump_lock_|
+  // held, so that a post finding |pump_| null can tell whether the pump is
+  // gone or not bound yet.
+  base::subtle::Atomic32 unbound_;
+
+  // Only read on other threads with |pump_lock_| held, to wake the pump up.
+  // The pump's thread reads it freely, since only that thread changes it.
+  base::Lock pump_lock_;
+  MessagePumpMojo* pump_;
+  scoped_refptr<base::SingleThreadTaskRunner> delayed_task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeTaskRunner);
+};
+
+}  // namespace common
+}  // namespace mojo
+
+#endif  // MOJO_COMMON_LOCK_FREE_TASK_RUNNER_H_
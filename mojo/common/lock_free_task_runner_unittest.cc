@@ -0,0 +1,249 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/common/lock_free_task_runner.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/threading/thread.h"
+#include "mojo/common/message_pump_mojo.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace common {
+namespace test {
+namespace {
+
+class LockFreeTaskRunnerTest : public testing::Test {
+ public:
+  LockFreeTaskRunnerTest()
+      : message_loop_(MessagePumpMojo::Create()),
+        task_runner_(new LockFreeTaskRunner) {
+    MessagePumpMojo::current()->SetTaskRunner(task_runner_);
+    task_runner_->SetDelayedTaskRunner(message_loop_.task_runner());
+  }
+
+  LockFreeTaskRunner* task_runner() { return task_runner_.get(); }
+
+ private:
+  base::MessageLoop message_loop_;
+  scoped_refptr<LockFreeTaskRunner> task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeTaskRunnerTest);
+};
+
+void Append(std::vector<int>* values, int value) {
+  values->push_back(value);
+}
+
+void PostFromThread(LockFreeTaskRunner* task_runner,
+                    std::vector<int>* values,
+                    int first,
+                    int count) {
+  for (int i = first; i < first + count; ++i)
+    task_runner->PostTask(FROM_HERE, base::Bind(&Append, values, i));
+}
+
+void PostAndRecordResult(LockFreeTaskRunner* task_runner,
+                         std::vector<int>* values,
+                         int value,
+                         bool* posted) {
+  *posted = task_runner->PostTask(FROM_HERE, base::Bind(&Append, values, value));
+}
+
+TEST_F(LockFreeTaskRunnerTest, RunsTasksInOrder) {
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i)
+    task_runner()->PostTask(FROM_HERE, base::Bind(&Append, &values, i));
+
+  base::RunLoop run_loop;
+  task_runner()->PostTask(FROM_HERE, run_loop.QuitClosure());
+  run_loop.Run();
+
+  ASSERT_EQ(1000u, values.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, values[i]);
+}
+
+TEST_F(LockFreeTaskRunnerTest, PreservesOrderPerProducer) {
+  const int kProducers = 4;
+  const int kTasksPerProducer = 10000;
+
+  // Each producer posts its own contiguous range of values. Tasks only touch
+  // |values| on the pump's thread.
+  std::vector<int> values;
+  {
+    std::vector<base::Thread*> threads;
+    for (int i = 0; i < kProducers; ++i) {
+      base::Thread* thread = new base::Thread("producer");
+      thread->Start();
+      thread->task_runner()->PostTask(
+          FROM_HERE, base::Bind(&PostFromThread, base::Unretained(task_runner()),
+                                &values, i * kTasksPerProducer,
+                                kTasksPerProducer));
+      threads.push_back(thread);
+    }
+    for (base::Thread* thread : threads) {
+      thread->Stop();
+      delete thread;
+    }
+  }
+
+  base::RunLoop run_loop;
+  task_runner()->PostTask(FROM_HERE, run_loop.QuitClosure());
+  run_loop.Run();
+
+  ASSERT_EQ(static_cast<size_t>(kProducers * kTasksPerProducer),
+            values.size());
+  std::vector<int> last_seen(kProducers, -1);
+  for (int value : values) {
+    int producer = value / kTasksPerProducer;
+    EXPECT_LT(last_seen[producer], value);
+    last_seen[producer] = value;
+  }
+}
+
+TEST_F(LockFreeTaskRunnerTest, ForwardsDelayedTasks) {
+  std::vector<int> values;
+  base::RunLoop run_loop;
+  task_runner()->PostDelayedTask(FROM_HERE, base::Bind(&Append, &values, 2),
+                                 base::TimeDelta::FromMilliseconds(5));
+  task_runner()->PostDelayedTask(FROM_HERE, run_loop.QuitClosure(),
+                                 base::TimeDelta::FromMilliseconds(10));
+  task_runner()->PostTask(FROM_HERE, base::Bind(&Append, &values, 1));
+  run_loop.Run();
+
+  ASSERT_EQ(2u, values.size());
+  EXPECT_EQ(1, values[0]);
+  EXPECT_EQ(2, values[1]);
+}
+
+// Posts |value| to |task_runner|, then spins a nested loop until idle.
+void PostAndRunNestedLoop(LockFreeTaskRunner* task_runner,
+                          std::vector<int>* values,
+                          int value,
+                          bool allow_nestable_tasks) {
+  task_runner->PostTask(FROM_HERE, base::Bind(&Append, values, value));
+  if (allow_nestable_tasks) {
+    base::MessageLoop::ScopedNestableTaskAllower allow(
+        base::MessageLoop::current());
+    base::RunLoop().RunUntilIdle();
+  } else {
+    base::RunLoop().RunUntilIdle();
+  }
+  values->push_back(-1);
+}
+
+TEST_F(LockFreeTaskRunnerTest, NestedLoopWithoutNestableTasks) {
+  std::vector<int> values;
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE, base::Bind(&PostAndRunNestedLoop,
+                            base::Unretained(task_runner()), &values, 1,
+                            false));
+  base::RunLoop().RunUntilIdle();
+
+  // The task waited for the nested loop to finish.
+  ASSERT_EQ(2u, values.size());
+  EXPECT_EQ(-1, values[0]);
+  EXPECT_EQ(1, values[1]);
+}
+
+TEST_F(LockFreeTaskRunnerTest, NestedLoopWithNestableTasks) {
+  std::vector<int> values;
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE, base::Bind(&PostAndRunNestedLoop,
+                            base::Unretained(task_runner()), &values, 1,
+                            true));
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(2u, values.size());
+  EXPECT_EQ(1, values[0]);
+  EXPECT_EQ(-1, values[1]);
+}
+
+TEST_F(LockFreeTaskRunnerTest, NestedLoopInLockFreeTask) {
+  std::vector<int> values;
+  task_runner()->PostTask(
+      FROM_HERE, base::Bind(&PostAndRunNestedLoop,
+                            base::Unretained(task_runner()), &values, 1,
+                            false));
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(2u, values.size());
+  EXPECT_EQ(-1, values[0]);
+  EXPECT_EQ(1, values[1]);
+}
+
+// Tasks in the two queues are not ordered against each other, but each queue
+// keeps its own order.
+TEST_F(LockFreeTaskRunnerTest, InterleavesWithMessageLoopInQueueOrder) {
+  std::vector<int> lock_free_values;
+  std::vector<int> message_loop_values;
+  for (int i = 0; i < 10; ++i) {
+    task_runner()->PostTask(FROM_HERE,
+                            base::Bind(&Append, &lock_free_values, i));
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(&Append, &message_loop_values, i));
+  }
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(10u, lock_free_values.size());
+  ASSERT_EQ(10u, message_loop_values.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, lock_free_values[i]);
+    EXPECT_EQ(i, message_loop_values[i]);
+  }
+}
+
+TEST_F(LockFreeTaskRunnerTest, RunsTasksOnCurrentThread) {
+  EXPECT_TRUE(task_runner()->RunsTasksOnCurrentThread());
+}
+
+TEST(LockFreeTaskRunnerStartupTest, PostBeforePumpIsBound) {
+  base::MessageLoop message_loop(MessagePumpMojo::Create());
+  scoped_refptr<LockFreeTaskRunner> task_runner(new LockFreeTaskRunner);
+  task_runner->SetDelayedTaskRunner(message_loop.task_runner());
+  std::vector<int> values;
+  EXPECT_TRUE(
+      task_runner->PostTask(FROM_HERE, base::Bind(&Append, &values, 1)));
+
+  MessagePumpMojo::current()->SetTaskRunner(task_runner);
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(1u, values.size());
+  EXPECT_EQ(1, values[0]);
+}
+
+TEST(LockFreeTaskRunnerShutdownTest, PostFailsAfterPumpIsDestroyed) {
+  scoped_refptr<LockFreeTaskRunner> task_runner(new LockFreeTaskRunner);
+  std::vector<int> values;
+  {
+    base::MessageLoop message_loop(MessagePumpMojo::Create());
+    MessagePumpMojo::current()->SetTaskRunner(task_runner);
+    task_runner->SetDelayedTaskRunner(message_loop.task_runner());
+    // Never runs; deleted when the pump goes away.
+    EXPECT_TRUE(
+        task_runner->PostTask(FROM_HERE, base::Bind(&Append, &values, 1)));
+  }
+
+  base::Thread thread("poster");
+  thread.Start();
+  bool posted = true;
+  thread.task_runner()->PostTask(
+      FROM_HERE, base::Bind(&PostAndRecordResult,
+                            base::Unretained(task_runner.get()), &values, 2,
+                            &posted));
+  thread.Stop();
+
+  EXPECT_FALSE(posted);
+  EXPECT_TRUE(values.empty());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace common
+}  // namespace mojo
@@ -4,14 +4,18 @@
 
 #include "mojo/common/message_pump_mojo.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <vector>
 
 #include "base/debug/alias.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/message_loop/message_loop.h"
 #include "base/threading/thread_local.h"
 #include "base/time/time.h"
+#include "mojo/common/lock_free_task_runner.h"
 #include "mojo/common/message_pump_mojo_handler.h"
 #include "mojo/common/time_helper.h"
 
@@ -22,6 +26,37 @@ namespace {
 base::LazyInstance<base::ThreadLocalPointer<MessagePumpMojo> >::Leaky
     g_tls_current_pump = LAZY_INSTANCE_INITIALIZER;
 
+// The number of LockFreeTaskRunner tasks run per iteration of the run loop
+// before handles and MessageLoop tasks get another turn.
+const size_t kMaxLockFreeTasksPerIteration = 64;
+
+// The number of ready handles serviced per wakeup. Any others are reported
+// (first) by the next wait.
+const uint32_t kMaxReadyHandlesPerWakeup = 64;
+
+// Wait set cookies. A handler's cookie holds its handle and its id, so that a
+// handle that is removed and added again while a wakeup is being serviced is
+// not notified for the old registration. The read ends of control pipes are
+// marked with |kControlPipeCookie|.
+const uint64_t kControlPipeCookie = static_cast<uint64_t>(1) << 63;
+
+// Handler ids take the 31 bits between the handle and |kControlPipeCookie|.
+const int kMaxHandlerId = 0x7fffffff;
+
+uint64_t HandlerCookie(const Handle& handle, int id) {
+  DCHECK(id >= 0 && id <= kMaxHandlerId);
+  return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32) |
+         handle.value();
+}
+
+Handle CookieHandle(uint64_t cookie) {
+  return Handle(static_cast<MojoHandle>(cookie & 0xffffffff));
+}
+
+int CookieHandlerId(uint64_t cookie) {
+  return static_cast<int>((cookie >> 32) & kMaxHandlerId);
+}
+
 MojoDeadline TimeTicksToMojoDeadline(base::TimeTicks time_ticks,
                                      base::TimeTicks now) {
   // The is_null() check matches that of HandleWatcher as well as how
@@ -35,13 +70,6 @@ MojoDeadline TimeTicksToMojoDeadline(base::TimeTicks time_ticks,
 
 }  // namespace
 
-// State needed for one iteration of WaitMany. The first handle and flags
-// corresponds to that of the control pipe.
-struct MessagePumpMojo::WaitState {
-  std::vector<Handle> handles;
-  std::vector<MojoHandleSignals> wait_signals;
-};
-
 struct MessagePumpMojo::RunState {
   RunState() : should_quit(false) {
     CreateMessagePipe(NULL, &read_handle, &write_handle);
@@ -53,21 +81,29 @@ struct MessagePumpMojo::RunState {
   ScopedMessagePipeHandle read_handle;
   ScopedMessagePipeHandle write_handle;
 
-  // Cached structures to avoid the heap allocation cost of std::vector<>.
-  scoped_ptr<WaitState> wait_state;
-  scoped_ptr<HandleToHandlerList> cloned_handlers;
-
   bool should_quit;
 };
 
-MessagePumpMojo::MessagePumpMojo() : run_state_(NULL), next_handler_id_(0) {
+MessagePumpMojo::MessagePumpMojo() : MessagePumpMojo(true) {
+}
+
+MessagePumpMojo::MessagePumpMojo(bool use_wait_set)
+    : run_state_(NULL), next_handler_id_(0) {
   DCHECK(!current())
       << "There is already a MessagePumpMojo instance on this thread.";
   g_tls_current_pump.Pointer()->Set(this);
+  if (use_wait_set) {
+    // An embedder that predates wait sets leaves |wait_set_| invalid.
+    // TODO: better deal with error handling.
+    const MojoResult result = CreateWaitSet(&wait_set_);
+    CHECK(result == MOJO_RESULT_OK || result == MOJO_RESULT_UNIMPLEMENTED);
+  }
 }
 
 MessagePumpMojo::~MessagePumpMojo() {
   DCHECK_EQ(this, current());
+  if (task_runner_)
+    task_runner_->UnbindFromPump();
   g_tls_current_pump.Pointer()->Set(NULL);
 }
 
@@ -76,6 +112,12 @@ scoped_ptr<base::MessagePump> MessagePumpMojo::Create() {
   return scoped_ptr<MessagePump>(new MessagePumpMojo());
 }
 
+// static
+scoped_ptr<base::MessagePump>
+MessagePumpMojo::CreateWithoutWaitSetForTesting() {
+  return scoped_ptr<MessagePump>(new MessagePumpMojo(false));
+}
+
 // static
 MessagePumpMojo* MessagePumpMojo::current() {
   return g_tls_current_pump.Pointer()->Get();
@@ -93,12 +135,28 @@ void MessagePumpMojo::AddHandler(MessagePumpMojoHandler* handler,
   handler_data.handler = handler;
   handler_data.wait_signals = wait_signals;
   handler_data.deadline = deadline;
-  handler_data.id = next_handler_id_++;
+  handler_data.id = next_handler_id_;
+  next_handler_id_ =
+      next_handler_id_ == kMaxHandlerId ? 0 : next_handler_id_ + 1;
+  if (wait_set_.is_valid()) {
+    CHECK_EQ(MOJO_RESULT_OK,
+             WaitSetAdd(wait_set_.get(), handle, wait_signals,
+                        HandlerCookie(handle, handler_data.id)));
+  }
   handlers_[handle] = handler_data;
+  if (!deadline.is_null())
+    deadlines_.insert(std::make_pair(deadline, handle));
 }
 
 void MessagePumpMojo::RemoveHandler(const Handle& handle) {
-  handlers_.erase(handle);
+  HandleToHandler::iterator it = handlers_.find(handle);
+  if (it == handlers_.end())
+    return;
+  if (wait_set_.is_valid())
+    WaitSetRemove(wait_set_.get(), HandlerCookie(handle, it->second.id));
+  if (!it->second.deadline.is_null())
+    deadlines_.erase(std::make_pair(it->second.deadline, handle));
+  handlers_.erase(it);
 }
 
 void MessagePumpMojo::AddObserver(Observer* observer) {
@@ -109,11 +167,26 @@ void MessagePumpMojo::RemoveObserver(Observer* observer) {
   observers_.RemoveObserver(observer);
 }
 
+void MessagePumpMojo::SetTaskRunner(
+    scoped_refptr<LockFreeTaskRunner> task_runner) {
+  DCHECK_EQ(this, current());
+  DCHECK(!task_runner_);
+  task_runner_ = task_runner;
+  task_runner_->BindToPump(this);
+}
+
 void MessagePumpMojo::Run(Delegate* delegate) {
   RunState run_state;
   // TODO: better deal with error handling.
   CHECK(run_state.read_handle.is_valid());
   CHECK(run_state.write_handle.is_valid());
+  const uint64_t control_pipe_cookie =
+      kControlPipeCookie | run_state.read_handle.get().value();
+  if (wait_set_.is_valid()) {
+    CHECK_EQ(MOJO_RESULT_OK,
+             WaitSetAdd(wait_set_.get(), run_state.read_handle.get(),
+                        MOJO_HANDLE_SIGNAL_READABLE, control_pipe_cookie));
+  }
   RunState* old_state = NULL;
   {
     base::AutoLock auto_lock(run_state_lock_);
@@ -125,6 +198,8 @@ void MessagePumpMojo::Run(Delegate* delegate) {
     base::AutoLock auto_lock(run_state_lock_);
     run_state_ = old_state;
   }
+  if (wait_set_.is_valid())
+    WaitSetRemove(wait_set_.get(), control_pipe_cookie);
 }
 
 void MessagePumpMojo::Quit() {
@@ -160,6 +235,17 @@ void MessagePumpMojo::DoRunLoop(RunState* run_state, Delegate* delegate) {
     if (run_state->should_quit)
       break;
 
+    // As with the MessageLoop's own queue, a nested loop only runs these if
+    // nestable tasks are allowed.
+    base::MessageLoop* message_loop = base::MessageLoop::current();
+    if (task_runner_ &&
+        (!message_loop || message_loop->NestableTasksAllowed())) {
+      more_work_is_plausible |=
+          task_runner_->RunPendingTasks(kMaxLockFreeTasksPerIteration);
+      if (run_state->should_quit)
+        break;
+    }
+
     more_work_is_plausible |= delegate->DoDelayedWork(
         &run_state->delayed_work_time);
     if (run_state->should_quit)
@@ -176,109 +262,127 @@ void MessagePumpMojo::DoRunLoop(RunState* run_state, Delegate* delegate) {
 
 bool MessagePumpMojo::DoInternalWork(const RunState& run_state, bool block) {
   const MojoDeadline deadline = block ? GetDeadlineForWait(run_state) : 0;
-  if (!run_state_->wait_state)
-    run_state_->wait_state.reset(new WaitState);
-  GetWaitState(run_state, run_state_->wait_state.get());
-
-  const WaitManyResult wait_many_result =
-      WaitMany(run_state_->wait_state->handles,
-               run_state_->wait_state->wait_signals, deadline, nullptr);
-  const MojoResult result = wait_many_result.result;
+  MojoWaitSetResult wait_set_results[kMaxReadyHandlesPerWakeup];
+  uint32_t num_results = kMaxReadyHandlesPerWakeup;
+  const MojoResult result =
+      wait_set_.is_valid()
+          ? WaitSetWait(wait_set_.get(), deadline, &num_results,
+                        wait_set_results)
+          : WaitManyForResults(run_state, deadline, &num_results,
+                               wait_set_results);
   bool did_work = true;
   if (result == MOJO_RESULT_OK) {
-    if (wait_many_result.index == 0) {
-      // Control pipe was written to.
-      ReadMessageRaw(run_state.read_handle.get(), NULL, NULL, NULL, NULL,
-                     MOJO_READ_MESSAGE_FLAG_MAY_DISCARD);
-    } else {
-      DCHECK(handlers_.find(
-                 run_state_->wait_state->handles[wait_many_result.index]) !=
-             handlers_.end());
-      WillSignalHandler();
-      handlers_[run_state_->wait_state->handles[wait_many_result.index]]
-          .handler->OnHandleReady(
-              run_state_->wait_state->handles[wait_many_result.index]);
-      DidSignalHandler();
-    }
+    for (uint32_t i = 0; i < num_results; i++)
+      SignalHandler(wait_set_results[i]);
+  } else if (result == MOJO_RESULT_DEADLINE_EXCEEDED) {
+    did_work = false;
   } else {
-    switch (result) {
-      case MOJO_RESULT_CANCELLED:
-      case MOJO_RESULT_FAILED_PRECONDITION:
-        RemoveInvalidHandle(*run_state_->wait_state, result,
-                            wait_many_result.index);
-        break;
-      case MOJO_RESULT_DEADLINE_EXCEEDED:
-        did_work = false;
-        break;
-      default:
-        base::debug::Alias(&result);
-        // Unexpected result is likely fatal, crash so we can determine cause.
-        CHECK(false);
-    }
+    base::debug::Alias(&result);
+    // Unexpected result is likely fatal, crash so we can determine cause.
+    CHECK(false);
   }
-  // To keep memory usage under control, delete the WaitState object at the end
-  // if it's vectors are too big by a factor of 2. Pre-C++11 doesn't have a way
-  // to shrink vectors, so just get rid of them and re-create on the next round.
-  if (run_state_->wait_state->handles.capacity() >
-      2 * run_state_->wait_state->handles.size()) {
-    // NOTE: |handles| and |wait_signals| are always in sync, so it's reasonable
-    // to only check one of those.
-    run_state_->wait_state.reset();
+
+  if (RemoveExpiredHandlers())
+    did_work = true;
+  return did_work;
+}
+
+MojoResult MessagePumpMojo::WaitManyForResults(const RunState& run_state,
+                                               MojoDeadline deadline,
+                                               uint32_t* num_results,
+                                               MojoWaitSetResult* results) {
+  DCHECK_GE(*num_results, 1u);
+  std::vector<Handle> handles;
+  std::vector<MojoHandleSignals> signals;
+  std::vector<uint64_t> cookies;
+  handles.reserve(handlers_.size() + 1);
+  signals.reserve(handlers_.size() + 1);
+  cookies.reserve(handlers_.size() + 1);
+  handles.push_back(run_state.read_handle.get());
+  signals.push_back(MOJO_HANDLE_SIGNAL_READABLE);
+  cookies.push_back(kControlPipeCookie | run_state.read_handle.get().value());
+  for (const auto& handler : handlers_) {
+    handles.push_back(handler.first);
+    signals.push_back(handler.second.wait_signals);
+    cookies.push_back(HandlerCookie(handler.first, handler.second.id));
   }
 
-  // Notify and remove any handlers whose time has expired. Make a copy in case
-  // someone tries to add/remove new handlers from notification.
-  if (!run_state_->cloned_handlers) {
-    run_state_->cloned_handlers.reset(new HandleToHandlerList);
-  } else {
-    run_state_->cloned_handlers->clear();
+  const WaitManyResult wait_many_result =
+      mojo::WaitMany(handles, signals, deadline, nullptr);
+  const MojoResult result = wait_many_result.result;
+  if ((result != MOJO_RESULT_OK && result != MOJO_RESULT_CANCELLED &&
+       result != MOJO_RESULT_FAILED_PRECONDITION) ||
+      !wait_many_result.IsIndexValid()) {
+    return result;
   }
-  run_state_->cloned_handlers->reserve(handlers_.size());
-  for (const auto& handler : handlers_) {
-    run_state_->cloned_handlers->push_back(handler);
+  memset(results, 0, sizeof(*results));
+  results[0].cookie = cookies[wait_many_result.index];
+  results[0].wait_result = result;
+  *num_results = 1;
+  return MOJO_RESULT_OK;
+}
+
+void MessagePumpMojo::SignalHandler(const MojoWaitSetResult& wait_set_result) {
+  const Handle handle = CookieHandle(wait_set_result.cookie);
+  if (wait_set_result.cookie & kControlPipeCookie) {
+    // A control pipe was written to. This may be the control pipe of an outer
+    // Run(), which is fine: the message only exists to wake us up.
+    // TODO(sky): deal with control pipe going bad.
+    CHECK_EQ(MOJO_RESULT_OK, wait_set_result.wait_result);
+    ReadMessageRaw(MessagePipeHandle(handle.value()), NULL, NULL, NULL, NULL,
+                   MOJO_READ_MESSAGE_FLAG_MAY_DISCARD);
+    return;
   }
-  const base::TimeTicks now(internal::NowTicks());
-  for (HandleToHandlerList::const_iterator i =
-           run_state_->cloned_handlers->begin();
-       i != run_state_->cloned_handlers->end(); ++i) {
-    // Since we're iterating over a clone of the handlers, verify the handler is
-    // still valid before notifying.
-    if (!i->second.deadline.is_null() && i->second.deadline < now &&
-        handlers_.find(i->first) != handlers_.end() &&
-        handlers_[i->first].id == i->second.id) {
-      WillSignalHandler();
-      i->second.handler->OnHandleError(i->first, MOJO_RESULT_DEADLINE_EXCEEDED);
-      DidSignalHandler();
-      handlers_.erase(i->first);
-      did_work = true;
-    }
+
+  // An earlier handler for this wakeup may have removed (and possibly re-added)
+  // this handle.
+  HandleToHandler::iterator it = handlers_.find(handle);
+  if (it == handlers_.end() ||
+      it->second.id != CookieHandlerId(wait_set_result.cookie)) {
+    return;
   }
-  if (run_state_->cloned_handlers->capacity() >
-      2 * run_state_->cloned_handlers->size()) {
-    run_state_->cloned_handlers.reset();
+
+  if (wait_set_result.wait_result != MOJO_RESULT_OK) {
+    RemoveInvalidHandle(handle, wait_set_result.wait_result);
+    return;
   }
-  return did_work;
+  WillSignalHandler();
+  it->second.handler->OnHandleReady(handle);
+  DidSignalHandler();
 }
 
-void MessagePumpMojo::RemoveInvalidHandle(const WaitState& wait_state,
-                                          MojoResult result,
-                                          uint32_t index) {
-  // TODO(sky): deal with control pipe going bad.
+void MessagePumpMojo::RemoveInvalidHandle(const Handle& handle,
+                                          MojoResult result) {
   CHECK(result == MOJO_RESULT_FAILED_PRECONDITION ||
         result == MOJO_RESULT_CANCELLED);
-  CHECK_NE(index, 0u);  // Indicates the control pipe went bad.
 
   // Remove the handle first, this way if OnHandleError() tries to remove the
   // handle our iterator isn't invalidated.
-  CHECK(handlers_.find(wait_state.handles[index]) != handlers_.end());
-  MessagePumpMojoHandler* handler =
-      handlers_[wait_state.handles[index]].handler;
-  handlers_.erase(wait_state.handles[index]);
+  CHECK(handlers_.find(handle) != handlers_.end());
+  MessagePumpMojoHandler* handler = handlers_[handle].handler;
+  RemoveHandler(handle);
   WillSignalHandler();
-  handler->OnHandleError(wait_state.handles[index], result);
+  handler->OnHandleError(handle, result);
   DidSignalHandler();
 }
 
+bool MessagePumpMojo::RemoveExpiredHandlers() {
+  bool did_work = false;
+  const base::TimeTicks now(internal::NowTicks());
+  // Remove each handler before notifying it, so that handlers may add or
+  // remove handlers from the notification.
+  while (!deadlines_.empty() && deadlines_.begin()->first < now) {
+    const Handle handle = deadlines_.begin()->second;
+    MessagePumpMojoHandler* handler = handlers_[handle].handler;
+    RemoveHandler(handle);
+    WillSignalHandler();
+    handler->OnHandleError(handle, MOJO_RESULT_DEADLINE_EXCEEDED);
+    DidSignalHandler();
+    did_work = true;
+  }
+  return did_work;
+}
+
 void MessagePumpMojo::SignalControlPipe(const RunState& run_state) {
   const MojoResult result =
       WriteMessageRaw(run_state.write_handle.get(), NULL, 0, NULL, 0,
@@ -288,33 +392,14 @@ void MessagePumpMojo::SignalControlPipe(const RunState& run_state) {
   CHECK_EQ(MOJO_RESULT_OK, result);
 }
 
-void MessagePumpMojo::GetWaitState(
-    const RunState& run_state,
-    MessagePumpMojo::WaitState* wait_state) const {
-  const size_t num_handles = handlers_.size() + 1;
-  wait_state->handles.clear();
-  wait_state->handles.reserve(num_handles);
-  wait_state->wait_signals.clear();
-  wait_state->wait_signals.reserve(num_handles);
-  wait_state->handles.push_back(run_state.read_handle.get());
-  wait_state->wait_signals.push_back(MOJO_HANDLE_SIGNAL_READABLE);
-
-  for (HandleToHandler::const_iterator i = handlers_.begin();
-       i != handlers_.end(); ++i) {
-    wait_state->handles.push_back(i->first);
-    wait_state->wait_signals.push_back(i->second.wait_signals);
-  }
-}
-
 MojoDeadline MessagePumpMojo::GetDeadlineForWait(
     const RunState& run_state) const {
   const base::TimeTicks now(internal::NowTicks());
   MojoDeadline deadline = TimeTicksToMojoDeadline(run_state.delayed_work_time,
                                                   now);
-  for (HandleToHandler::const_iterator i = handlers_.begin();
-       i != handlers_.end(); ++i) {
-    deadline = std::min(
-        TimeTicksToMojoDeadline(i->second.deadline, now), deadline);
+  if (!deadlines_.empty()) {
+    deadline = std::min(TimeTicksToMojoDeadline(deadlines_.begin()->first, now),
+                        deadline);
   }
   return deadline;
 }
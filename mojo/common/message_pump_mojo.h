@@ -6,10 +6,11 @@
 #define MOJO_COMMON_MESSAGE_PUMP_MOJO_H_
 
 #include <map>
+#include <set>
 #include <utility>
-#include <vector>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop/message_pump.h"
 #include "base/observer_list.h"
@@ -20,6 +21,7 @@
 namespace mojo {
 namespace common {
 
+class LockFreeTaskRunner;
 class MessagePumpMojoHandler;
 
 // Mojo implementation of MessagePump.
@@ -43,6 +45,10 @@ class MessagePumpMojo : public base::MessagePump {
   // using |base::Bind()|).
   static scoped_ptr<base::MessagePump> Create();
 
+  // Creates a pump that waits with MojoWaitMany(), as every pump does when
+  // the embedder predates wait sets.
+  static scoped_ptr<base::MessagePump> CreateWithoutWaitSetForTesting();
+
   // Returns the MessagePumpMojo instance of the current thread, if it exists.
   static MessagePumpMojo* current();
 
@@ -61,6 +67,11 @@ class MessagePumpMojo : public base::MessagePump {
   void AddObserver(Observer* observer);
   void RemoveObserver(Observer* observer);
 
+  // Installs a LockFreeTaskRunner whose tasks this pump runs between waits.
+  // Must be called on the pump's thread before Run(). Tasks from the runner
+  // are bracketed by the same observer calls as handle notifications.
+  void SetTaskRunner(scoped_refptr<LockFreeTaskRunner> task_runner);
+
   // MessagePump:
   void Run(Delegate* delegate) override;
   void Quit() override;
@@ -68,8 +79,11 @@ class MessagePumpMojo : public base::MessagePump {
   void ScheduleDelayedWork(const base::TimeTicks& delayed_work_time) override;
 
  private:
+  friend class LockFreeTaskRunner;
+
   struct RunState;
-  struct WaitState;
+
+  explicit MessagePumpMojo(bool use_wait_set);
 
   // Contains the data needed to track a request to AddHandler().
   struct Handler {
@@ -83,7 +97,7 @@ class MessagePumpMojo : public base::MessagePump {
   };
 
   typedef std::map<Handle, Handler> HandleToHandler;
-  typedef std::vector<std::pair<Handle, Handler>> HandleToHandlerList;
+  typedef std::set<std::pair<base::TimeTicks, Handle>> HandlerDeadlines;
 
   // Implementation of Run().
   void DoRunLoop(RunState* run_state, Delegate* delegate);
@@ -93,17 +107,28 @@ class MessagePumpMojo : public base::MessagePump {
   // handle has become ready, |false| otherwise.
   bool DoInternalWork(const RunState& run_state, bool block);
 
-  // Removes the given invalid handle. This is called if MojoWaitMany finds an
-  // invalid handle.
-  void RemoveInvalidHandle(const WaitState& wait_state,
-                           MojoResult result,
-                           uint32_t result_index);
+  // Waits on the control pipe of |run_state| and every handler with
+  // MojoWaitMany(), for pumps without |wait_set_|. Reports the handle it
+  // returns in |results| like MojoWaitSetWait() would.
+  MojoResult WaitManyForResults(const RunState& run_state,
+                                MojoDeadline deadline,
+                                uint32_t* num_results,
+                                MojoWaitSetResult* results);
 
-  void SignalControlPipe(const RunState& run_state);
+  // Notifies the handler of a handle that was reported ready.
+  void SignalHandler(const MojoWaitSetResult& wait_set_result);
+
+  // Removes the given invalid handle. This is called if |wait_set_| reports
+  // that a handle was closed or can no longer satisfy its signals.
+  void RemoveInvalidHandle(const Handle& handle, MojoResult result);
 
-  void GetWaitState(const RunState& run_state, WaitState* wait_state) const;
+  // Notifies and removes the handlers whose deadline has passed. Returns true
+  // if any were.
+  bool RemoveExpiredHandlers();
 
-  // Returns the deadline for the call to MojoWaitMany().
+  void SignalControlPipe(const RunState& run_state);
+
+  // Returns the deadline for the call to MojoWaitSetWait().
   MojoDeadline GetDeadlineForWait(const RunState& run_state) const;
 
   void WillSignalHandler();
@@ -118,17 +143,31 @@ class MessagePumpMojo : public base::MessagePump {
   // thread.
   base::Lock run_state_lock_;
 
+  // Every registered handle, and the read end of the control pipe of every
+  // active Run(), is a member of this wait set. It stays registered with the
+  // handles between waits, so a wait costs time proportional to the number of
+  // ready handles rather than the number of registered ones. Invalid if the
+  // embedder doesn't provide wait sets; see WaitManyForResults().
+  ScopedWaitSetHandle wait_set_;
+
   HandleToHandler handlers_;
 
-  // An ever increasing value assigned to each Handler::id. Used to detect
-  // uniqueness while notifying. That is, while notifying expired timers we copy
-  // |handlers_| and only notify handlers whose id match. If the id does not
-  // match it means the handler was removed then added so that we shouldn't
-  // notify it.
+  // The handlers that have a deadline, soonest first.
+  HandlerDeadlines deadlines_;
+
+  // An increasing value assigned to each Handler::id, which wraps around to 0
+  // after the largest id that fits in a wait set cookie. Used to detect
+  // uniqueness while notifying. That is, a handle's wait set cookie includes
+  // its handler's id, and a handle reported ready is only notified if the id
+  // still matches. If the id does not match it means the handler was removed
+  // (by an earlier notification for the same wakeup) then added so that we
+  // shouldn't notify it.
   int next_handler_id_;
 
   base::ObserverList<Observer> observers_;
 
+  scoped_refptr<LockFreeTaskRunner> task_runner_;
+
   DISALLOW_COPY_AND_ASSIGN(MessagePumpMojo);
 };
 
@@ -20,6 +20,13 @@ scoped_ptr<base::MessagePump> CreateMojoMessagePump() {
 
 RUN_MESSAGE_LOOP_TESTS(Mojo, &CreateMojoMessagePump);
 
+// The pump an embedder without wait sets gets.
+scoped_ptr<base::MessagePump> CreateWaitManyMessagePump() {
+  return MessagePumpMojo::CreateWithoutWaitSetForTesting();
+}
+
+RUN_MESSAGE_LOOP_TESTS(MojoWaitMany, &CreateWaitManyMessagePump);
+
 class CountingMojoHandler : public MessagePumpMojoHandler {
  public:
   CountingMojoHandler() : success_count_(0), error_count_(0) {}
@@ -119,6 +126,98 @@ TEST(MessagePumpMojo, UnregisterAfterDeadline) {
   EXPECT_EQ(1, handler.error_count());
 }
 
+// Removes another handle's handler when notified.
+class RemovingMojoHandler : public CountingMojoHandler {
+ public:
+  explicit RemovingMojoHandler(const Handle& handle_to_remove)
+      : handle_to_remove_(handle_to_remove) {}
+
+  void OnHandleReady(const Handle& handle) override {
+    CountingMojoHandler::OnHandleReady(handle);
+    MessagePumpMojo::current()->RemoveHandler(handle_to_remove_);
+  }
+
+ private:
+  Handle handle_to_remove_;
+
+  DISALLOW_COPY_AND_ASSIGN(RemovingMojoHandler);
+};
+
+TEST(MessagePumpMojo, RemovedHandlerIsNotNotified) {
+  base::MessageLoop message_loop(MessagePumpMojo::Create());
+  MessagePipe handles1;
+  MessagePipe handles2;
+  RemovingMojoHandler handler1(handles2.handle0.get());
+  CountingMojoHandler handler2;
+  MessagePumpMojo::current()->AddHandler(&handler1,
+                                         handles1.handle0.get(),
+                                         MOJO_HANDLE_SIGNAL_READABLE,
+                                         base::TimeTicks());
+  MessagePumpMojo::current()->AddHandler(&handler2,
+                                         handles2.handle0.get(),
+                                         MOJO_HANDLE_SIGNAL_READABLE,
+                                         base::TimeTicks());
+  // Both handles are ready for the same wakeup, |handles1| first.
+  WriteMessageRaw(
+      handles1.handle1.get(), NULL, 0, NULL, 0, MOJO_WRITE_MESSAGE_FLAG_NONE);
+  WriteMessageRaw(
+      handles2.handle1.get(), NULL, 0, NULL, 0, MOJO_WRITE_MESSAGE_FLAG_NONE);
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+  EXPECT_EQ(1, handler1.success_count());
+  EXPECT_EQ(0, handler2.success_count());
+  MessagePumpMojo::current()->RemoveHandler(handles1.handle0.get());
+}
+
+TEST(MessagePumpMojo, PeerClosed) {
+  base::MessageLoop message_loop(MessagePumpMojo::Create());
+  CountingMojoHandler handler;
+  MessagePipe handles;
+  MessagePumpMojo::current()->AddHandler(&handler,
+                                         handles.handle0.get(),
+                                         MOJO_HANDLE_SIGNAL_READABLE,
+                                         base::TimeTicks());
+  handles.handle1.reset();
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+  EXPECT_EQ(0, handler.success_count());
+  EXPECT_EQ(1, handler.error_count());
+}
+
+TEST(MessagePumpMojo, WaitManyRunUntilIdle) {
+  base::MessageLoop message_loop(
+      MessagePumpMojo::CreateWithoutWaitSetForTesting());
+  CountingMojoHandler handler;
+  MessagePipe handles;
+  MessagePumpMojo::current()->AddHandler(&handler,
+                                         handles.handle0.get(),
+                                         MOJO_HANDLE_SIGNAL_READABLE,
+                                         base::TimeTicks());
+  WriteMessageRaw(
+      handles.handle1.get(), NULL, 0, NULL, 0, MOJO_WRITE_MESSAGE_FLAG_NONE);
+  WriteMessageRaw(
+      handles.handle1.get(), NULL, 0, NULL, 0, MOJO_WRITE_MESSAGE_FLAG_NONE);
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+  EXPECT_EQ(2, handler.success_count());
+}
+
+TEST(MessagePumpMojo, WaitManyPeerClosed) {
+  base::MessageLoop message_loop(
+      MessagePumpMojo::CreateWithoutWaitSetForTesting());
+  CountingMojoHandler handler;
+  MessagePipe handles;
+  MessagePumpMojo::current()->AddHandler(&handler,
+                                         handles.handle0.get(),
+                                         MOJO_HANDLE_SIGNAL_READABLE,
+                                         base::TimeTicks());
+  handles.handle1.reset();
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+  EXPECT_EQ(0, handler.success_count());
+  EXPECT_EQ(1, handler.error_count());
+}
+
 }  // namespace test
 }  // namespace common
 }  // namespace mojo
@@ -4,6 +4,8 @@
 
 #include <stdio.h>
 #include <string.h>
+
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -34,6 +36,8 @@ namespace dart {
   V(MojoMessagePipe_Create, 1)             \
   V(MojoMessagePipe_Write, 5)              \
   V(MojoMessagePipe_Read, 5)               \
+  V(MojoMessagePipe_ReadAll, 4)            \
+  V(MojoMessagePipe_WriteAll, 5)           \
   V(MojoHandle_Close, 1)                   \
   V(MojoHandle_Wait, 3)                    \
   V(MojoHandle_Register, 2)                \
@@ -716,6 +720,236 @@ void MojoMessagePipe_Read(Dart_NativeArguments arguments) {
   Dart_SetReturnValue(arguments, list);
 }
 
+// Upper bound on the number of messages |MojoMessagePipe_ReadAll()| reads in
+// one call, so that a fast writer can't keep the reader in native code.
+static const uint32_t kMaxMessagesPerReadAll = 1024;
+
+static_assert(sizeof(MojoHandle) == sizeof(uint32_t),
+              "MojoHandle doesn't fit a Uint32List element");
+
+static bool IsTypedDataOfType(Dart_Handle handle, Dart_TypedData_Type type) {
+  return Dart_GetTypeOfTypedData(handle) == type;
+}
+
+// Returns a ByteData of at least |min_length| bytes (and at least twice as long
+// as |byte_data|) whose first |used| bytes are those of |byte_data|. The data
+// of |byte_data| must not be acquired.
+static Dart_Handle GrowByteData(Dart_Handle byte_data,
+                                intptr_t used,
+                                intptr_t min_length) {
+  std::vector<uint8_t> prefix(used);
+  intptr_t length = 0;
+  Dart_TypedData_Type type;
+  void* data = nullptr;
+  Dart_TypedDataAcquireData(byte_data, &type, &data, &length);
+  if (used > 0)
+    memcpy(prefix.data(), data, used);
+  Dart_TypedDataReleaseData(byte_data);
+
+  intptr_t new_length = std::max(min_length, 2 * length);
+  Dart_Handle grown = Dart_NewTypedData(Dart_TypedData_kByteData, new_length);
+  if (used > 0) {
+    Dart_TypedDataAcquireData(grown, &type, &data, &length);
+    memcpy(data, prefix.data(), used);
+    Dart_TypedDataReleaseData(grown);
+  }
+  return grown;
+}
+
+// Copies |values| to the start of the Uint32List |list|, or to a new Uint32List
+// (twice as long as needed) if |list| is too short. Returns the list written.
+static Dart_Handle CopyToUint32List(const std::vector<uint32_t>& values,
+                                    Dart_Handle list) {
+  Dart_TypedData_Type type;
+  void* data = nullptr;
+  intptr_t length = 0;
+  Dart_TypedDataAcquireData(list, &type, &data, &length);
+  if (length < static_cast<intptr_t>(values.size())) {
+    Dart_TypedDataReleaseData(list);
+    list = Dart_NewTypedData(Dart_TypedData_kUint32, 2 * values.size());
+    Dart_TypedDataAcquireData(list, &type, &data, &length);
+  }
+  if (!values.empty())
+    memcpy(data, values.data(), values.size() * sizeof(uint32_t));
+  Dart_TypedDataReleaseData(list);
+  return list;
+}
+
+// Copies the first |count| elements of the Uint32List |list| to |*values|.
+// Returns false if |list| is too short.
+static bool CopyFromUint32List(Dart_Handle list,
+                               intptr_t count,
+                               std::vector<uint32_t>* values) {
+  Dart_TypedData_Type type;
+  void* data = nullptr;
+  intptr_t length = 0;
+  Dart_TypedDataAcquireData(list, &type, &data, &length);
+  bool ok = length >= count;
+  if (ok && count > 0) {
+    const uint32_t* elements = reinterpret_cast<const uint32_t*>(data);
+    values->assign(elements, elements + count);
+  }
+  Dart_TypedDataReleaseData(list);
+  return ok;
+}
+
+// Reads all the messages pending on a message pipe (up to
+// |kMaxMessagesPerReadAll|) in one call. The messages' bytes are packed into
+// the ByteData argument and their handles into the Uint32List handles
+// argument; for message i, the Uint32List ends argument gets the end offset of
+// its bytes at [2 * i] and the end index of its handles at [2 * i + 1]. Any of
+// the three is replaced by a larger one when it is too short, so the caller
+// should keep the ones returned for the next call. Returns
+// [result, number of messages, bytes, ends, handles]; the result is
+// MOJO_RESULT_OK if any message was read, otherwise the result of reading the
+// first one.
+void MojoMessagePipe_ReadAll(Dart_NativeArguments arguments) {
+  int64_t handle = 0;
+  CHECK_INTEGER_ARGUMENT(arguments, 0, &handle, Null);
+
+  Dart_Handle bytes = Dart_GetNativeArgument(arguments, 1);
+  Dart_Handle ends = Dart_GetNativeArgument(arguments, 2);
+  Dart_Handle handles = Dart_GetNativeArgument(arguments, 3);
+  if (!IsTypedDataOfType(bytes, Dart_TypedData_kByteData) ||
+      !IsTypedDataOfType(ends, Dart_TypedData_kUint32) ||
+      !IsTypedDataOfType(handles, Dart_TypedData_kUint32)) {
+    SetNullReturn(arguments);
+    return;
+  }
+
+  std::vector<uint32_t> message_ends;
+  std::vector<uint32_t> mojo_handles;
+  uint32_t bytes_used = 0;
+  uint32_t num_messages = 0;
+  MojoResult res = MOJO_RESULT_OK;
+  while (num_messages < kMaxMessagesPerReadAll) {
+    // Try reading the next message into the space that's left.
+    Dart_TypedData_Type typ;
+    void* data = nullptr;
+    intptr_t bytes_len = 0;
+    Dart_TypedDataAcquireData(bytes, &typ, &data, &bytes_len);
+    uint32_t blen = static_cast<uint32_t>(bytes_len) - bytes_used;
+    uint32_t hlen = static_cast<uint32_t>(mojo_handles.capacity() -
+                                          mojo_handles.size());
+    size_t handles_used = mojo_handles.size();
+    mojo_handles.resize(mojo_handles.capacity());
+    res = MojoReadMessage(static_cast<MojoHandle>(handle),
+                          static_cast<uint8_t*>(data) + bytes_used, &blen,
+                          mojo_handles.data() + handles_used, &hlen,
+                          MOJO_READ_MESSAGE_FLAG_NONE);
+    Dart_TypedDataReleaseData(bytes);
+
+    if (res == MOJO_RESULT_RESOURCE_EXHAUSTED) {
+      // It didn't fit; |blen| and |hlen| now hold its size.
+      if (bytes_used + blen > static_cast<uint32_t>(bytes_len))
+        bytes = GrowByteData(bytes, bytes_used, bytes_used + blen);
+      mojo_handles.resize(handles_used + hlen);
+      Dart_TypedDataAcquireData(bytes, &typ, &data, &bytes_len);
+      res = MojoReadMessage(static_cast<MojoHandle>(handle),
+                            static_cast<uint8_t*>(data) + bytes_used, &blen,
+                            mojo_handles.data() + handles_used, &hlen,
+                            MOJO_READ_MESSAGE_FLAG_NONE);
+      Dart_TypedDataReleaseData(bytes);
+    }
+    mojo_handles.resize(res == MOJO_RESULT_OK ? handles_used + hlen
+                                              : handles_used);
+    if (res != MOJO_RESULT_OK)
+      break;
+
+    bytes_used += blen;
+    message_ends.push_back(bytes_used);
+    message_ends.push_back(static_cast<uint32_t>(mojo_handles.size()));
+    num_messages++;
+  }
+  // Whatever stopped the batch is reported by the next call.
+  if (num_messages > 0)
+    res = MOJO_RESULT_OK;
+
+  ends = CopyToUint32List(message_ends, ends);
+  handles = CopyToUint32List(mojo_handles, handles);
+
+  Dart_Handle list = Dart_NewList(5);
+  Dart_ListSetAt(list, 0, Dart_NewInteger(res));
+  Dart_ListSetAt(list, 1, Dart_NewInteger(num_messages));
+  Dart_ListSetAt(list, 2, bytes);
+  Dart_ListSetAt(list, 3, ends);
+  Dart_ListSetAt(list, 4, handles);
+  Dart_SetReturnValue(arguments, list);
+}
+
+// Writes the first |num_messages| messages packed as by
+// |MojoMessagePipe_ReadAll()| in one call, stopping at the first failure.
+// Returns [result, number of messages written]; the handles of the messages
+// that weren't written are still owned by the caller.
+void MojoMessagePipe_WriteAll(Dart_NativeArguments arguments) {
+  int64_t handle = 0;
+  CHECK_INTEGER_ARGUMENT(arguments, 0, &handle, Null);
+
+  Dart_Handle bytes = Dart_GetNativeArgument(arguments, 1);
+  Dart_Handle ends = Dart_GetNativeArgument(arguments, 2);
+  Dart_Handle handles = Dart_GetNativeArgument(arguments, 3);
+  if (!IsTypedDataOfType(bytes, Dart_TypedData_kByteData) ||
+      !IsTypedDataOfType(ends, Dart_TypedData_kUint32) ||
+      !IsTypedDataOfType(handles, Dart_TypedData_kUint32)) {
+    SetNullReturn(arguments);
+    return;
+  }
+
+  int64_t num_messages = 0;
+  CHECK_INTEGER_ARGUMENT(arguments, 4, &num_messages, Null);
+
+  std::vector<uint32_t> message_ends;
+  if (num_messages < 0 ||
+      !CopyFromUint32List(ends, 2 * num_messages, &message_ends)) {
+    SetNullReturn(arguments);
+    return;
+  }
+  intptr_t num_handles = num_messages > 0 ? message_ends.back() : 0;
+  std::vector<uint32_t> mojo_handles;
+  if (!CopyFromUint32List(handles, num_handles, &mojo_handles)) {
+    SetNullReturn(arguments);
+    return;
+  }
+
+  Dart_TypedData_Type typ;
+  void* data = nullptr;
+  intptr_t bytes_len = 0;
+  Dart_TypedDataAcquireData(bytes, &typ, &data, &bytes_len);
+
+  MojoResult res = MOJO_RESULT_OK;
+  uint32_t bytes_start = 0;
+  uint32_t handles_start = 0;
+  int64_t num_written = 0;
+  for (; num_written < num_messages; num_written++) {
+    uint32_t bytes_end = message_ends[2 * num_written];
+    uint32_t handles_end = message_ends[2 * num_written + 1];
+    if (bytes_end < bytes_start ||
+        static_cast<intptr_t>(bytes_end) > bytes_len ||
+        handles_end < handles_start ||
+        static_cast<intptr_t>(handles_end) > num_handles) {
+      res = MOJO_RESULT_INVALID_ARGUMENT;
+      break;
+    }
+    res = MojoWriteMessage(static_cast<MojoHandle>(handle),
+                           static_cast<const uint8_t*>(data) + bytes_start,
+                           bytes_end - bytes_start,
+                           mojo_handles.data() + handles_start,
+                           handles_end - handles_start,
+                           MOJO_WRITE_MESSAGE_FLAG_NONE);
+    if (res != MOJO_RESULT_OK)
+      break;
+    bytes_start = bytes_end;
+    handles_start = handles_end;
+  }
+
+  Dart_TypedDataReleaseData(bytes);
+
+  Dart_Handle list = Dart_NewList(2);
+  Dart_ListSetAt(list, 0, Dart_NewInteger(res));
+  Dart_ListSetAt(list, 1, Dart_NewInteger(num_written));
+  Dart_SetReturnValue(arguments, list);
+}
+
 struct ControlData {
   int64_t handle;
   Dart_Port port;
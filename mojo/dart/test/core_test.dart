@@ -138,6 +138,52 @@ basicMessagePipeTest() {
   Expect.isTrue(result.isOk);
 }
 
+batchedMessagePipeTest() {
+  MojoMessagePipe pipe = new MojoMessagePipe();
+  MojoMessagePipeEndpoint end0 = pipe.endpoints[0];
+  MojoMessagePipeEndpoint end1 = pipe.endpoints[1];
+
+  // Nothing to read, yet.
+  var batch = new MojoMessageBatch(4, 1);
+  Expect.equals(end0.readAll(batch), 0);
+  Expect.isTrue(end0.status.isShouldWait);
+
+  // Write more messages and bytes than the batch has room for, one of the
+  // messages carrying a handle.
+  MojoMessagePipe other = new MojoMessagePipe();
+  var outgoing = new MojoMessageBatch();
+  for (int i = 0; i < 10; i++) {
+    var data = new ByteData(i + 1);
+    data.setUint8(i, i);
+    outgoing.add(data, (i == 5) ? [other.endpoints[1].handle] : null);
+  }
+  Expect.equals(end1.writeAll(outgoing), 10);
+  Expect.isTrue(end1.status.isOk);
+
+  Expect.equals(end0.readAll(batch), 10);
+  Expect.isTrue(end0.status.isOk);
+  for (int i = 0; i < 10; i++) {
+    ByteData data = batch.messageData(i);
+    Expect.equals(data.lengthInBytes, i + 1);
+    Expect.equals(data.getUint8(i), i);
+    Expect.equals(batch.messageHandles(i).length, (i == 5) ? 1 : 0);
+  }
+
+  // The handle that was sent is connected to |other|.
+  MojoHandle received = batch.messageHandles(5)[0];
+  Expect.isTrue(other.endpoints[0].write(new ByteData(1)).isOk);
+  MojoWaitResult mwr = received.wait(MojoHandleSignals.kReadable, 0);
+  Expect.isTrue(mwr.result.isOk);
+
+  Expect.equals(end0.readAll(batch), 0);
+  Expect.isTrue(end0.status.isShouldWait);
+
+  received.close();
+  other.endpoints[0].close();
+  end0.close();
+  end1.close();
+}
+
 basicDataPipeTest() {
   MojoDataPipe pipe = new MojoDataPipe();
   Expect.isNotNull(pipe);
@@ -296,6 +342,7 @@ basicSharedBufferTest() {
 main() {
   invalidHandleTest();
   basicMessagePipeTest();
+  batchedMessagePipeTest();
   basicDataPipeTest();
   basicSharedBufferTest();
 }
@@ -8,6 +8,7 @@
 #include "mojo/public/c/system/data_pipe.h"
 #include "mojo/public/c/system/functions.h"
 #include "mojo/public/c/system/message_pipe.h"
+#include "mojo/public/c/system/wait_set.h"
 
 using mojo::embedder::internal::g_core;
 using mojo::system::MakeUserPointer;
@@ -152,4 +153,28 @@ MojoResult MojoUnmapBuffer(void* buffer) {
   return g_core->UnmapBuffer(MakeUserPointer(buffer));
 }
 
+MojoResult MojoCreateWaitSet(MojoHandle* wait_set_handle) {
+  return g_core->CreateWaitSet(MakeUserPointer(wait_set_handle));
+}
+
+MojoResult MojoWaitSetAdd(MojoHandle wait_set_handle,
+                          MojoHandle handle,
+                          MojoHandleSignals signals,
+                          uint64_t cookie) {
+  return g_core->WaitSetAdd(wait_set_handle, handle, signals, cookie);
+}
+
+MojoResult MojoWaitSetRemove(MojoHandle wait_set_handle, uint64_t cookie) {
+  return g_core->WaitSetRemove(wait_set_handle, cookie);
+}
+
+MojoResult MojoWaitSetWait(MojoHandle wait_set_handle,
+                           MojoDeadline deadline,
+                           uint32_t* num_results,
+                           MojoWaitSetResult* results) {
+  return g_core->WaitSetWait(wait_set_handle, deadline,
+                             MakeUserPointer(num_results),
+                             MakeUserPointer(results));
+}
+
 }  // extern "C"
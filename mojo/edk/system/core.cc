@@ -21,6 +21,7 @@
 #include "mojo/edk/system/message_pipe.h"
 #include "mojo/edk/system/message_pipe_dispatcher.h"
 #include "mojo/edk/system/shared_buffer_dispatcher.h"
+#include "mojo/edk/system/wait_set_dispatcher.h"
 #include "mojo/edk/system/waiter.h"
 #include "mojo/public/c/system/macros.h"
 #include "mojo/public/cpp/system/macros.h"
@@ -554,6 +555,76 @@ MojoResult Core::UnmapBuffer(UserPointer<void> buffer) {
   return mapping_table_.RemoveMapping(buffer.GetPointerValue());
 }
 
+MojoResult Core::CreateWaitSet(UserPointer<MojoHandle> wait_set_handle) {
+  scoped_refptr<WaitSetDispatcher> dispatcher = WaitSetDispatcher::Create();
+  MojoHandle h = AddDispatcher(dispatcher);
+  if (h == MOJO_HANDLE_INVALID) {
+    LOG(ERROR) << "Handle table full";
+    dispatcher->Close();
+    return MOJO_RESULT_RESOURCE_EXHAUSTED;
+  }
+
+  wait_set_handle.Put(h);
+  return MOJO_RESULT_OK;
+}
+
+MojoResult Core::WaitSetAdd(MojoHandle wait_set_handle,
+                            MojoHandle handle,
+                            MojoHandleSignals signals,
+                            uint64_t cookie) {
+  scoped_refptr<WaitSetDispatcher> wait_set(
+      GetWaitSetDispatcher(wait_set_handle));
+  if (!wait_set)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+  scoped_refptr<Dispatcher> dispatcher(GetDispatcher(handle));
+  if (!dispatcher)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  return wait_set->Add(dispatcher, signals, cookie);
+}
+
+MojoResult Core::WaitSetRemove(MojoHandle wait_set_handle, uint64_t cookie) {
+  scoped_refptr<WaitSetDispatcher> wait_set(
+      GetWaitSetDispatcher(wait_set_handle));
+  if (!wait_set)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  return wait_set->Remove(cookie);
+}
+
+MojoResult Core::WaitSetWait(MojoHandle wait_set_handle,
+                             MojoDeadline deadline,
+                             UserPointer<uint32_t> num_results,
+                             UserPointer<MojoWaitSetResult> results) {
+  scoped_refptr<WaitSetDispatcher> wait_set(
+      GetWaitSetDispatcher(wait_set_handle));
+  if (!wait_set)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+  uint32_t max_results = num_results.Get();
+  if (max_results == 0)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  std::vector<MojoWaitSetResult> wait_set_results;
+  MojoResult rv = wait_set->Wait(deadline, max_results, &wait_set_results);
+  if (rv != MOJO_RESULT_OK)
+    return rv;
+
+  DCHECK_LE(wait_set_results.size(), max_results);
+  uint32_t count = static_cast<uint32_t>(wait_set_results.size());
+  results.PutArray(&wait_set_results[0], count);
+  num_results.Put(count);
+  return MOJO_RESULT_OK;
+}
+
+scoped_refptr<WaitSetDispatcher> Core::GetWaitSetDispatcher(
+    MojoHandle wait_set_handle) {
+  scoped_refptr<Dispatcher> dispatcher(GetDispatcher(wait_set_handle));
+  if (!dispatcher || dispatcher->GetType() != Dispatcher::Type::WAIT_SET)
+    return nullptr;
+  return scoped_refptr<WaitSetDispatcher>(
+      static_cast<WaitSetDispatcher*>(dispatcher.get()));
+}
+
 // Note: We allow |handles| to repeat the same handle multiple times, since
 // different flags may be specified.
 // TODO(vtl): This incurs a performance cost in |Remove()|. Analyze this
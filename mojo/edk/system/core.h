@@ -19,6 +19,7 @@
 #include "mojo/public/c/system/data_pipe.h"
 #include "mojo/public/c/system/message_pipe.h"
 #include "mojo/public/c/system/types.h"
+#include "mojo/public/c/system/wait_set.h"
 #include "mojo/public/cpp/system/macros.h"
 
 namespace mojo {
@@ -31,6 +32,7 @@ namespace system {
 
 class Dispatcher;
 struct HandleSignalsState;
+class WaitSetDispatcher;
 
 // |Core| is an object that implements the Mojo system calls. All public methods
 // are thread-safe.
@@ -159,9 +161,26 @@ class MOJO_SYSTEM_IMPL_EXPORT Core {
                        MojoMapBufferFlags flags);
   MojoResult UnmapBuffer(UserPointer<void> buffer);
 
+  // These methods correspond to the API functions defined in
+  // "mojo/public/c/system/wait_set.h":
+  MojoResult CreateWaitSet(UserPointer<MojoHandle> wait_set_handle);
+  MojoResult WaitSetAdd(MojoHandle wait_set_handle,
+                        MojoHandle handle,
+                        MojoHandleSignals signals,
+                        uint64_t cookie);
+  MojoResult WaitSetRemove(MojoHandle wait_set_handle, uint64_t cookie);
+  MojoResult WaitSetWait(MojoHandle wait_set_handle,
+                         MojoDeadline deadline,
+                         UserPointer<uint32_t> num_results,
+                         UserPointer<MojoWaitSetResult> results);
+
  private:
   friend bool internal::ShutdownCheckNoLeaks(Core*);
 
+  // Like |GetDispatcher()|, but returns null unless the handle is a wait set.
+  scoped_refptr<WaitSetDispatcher> GetWaitSetDispatcher(
+      MojoHandle wait_set_handle);
+
   // Internal implementation of |Wait()| and |WaitMany()|; doesn't do basic
   // validation of arguments. |*result_index| is only set if the result (whether
   // success or failure) applies to a specific handle, so its value should be
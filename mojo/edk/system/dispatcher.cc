@@ -89,6 +89,10 @@ scoped_refptr<Dispatcher> Dispatcher::TransportDataAccess::Deserialize(
     case Type::SHARED_BUFFER:
       return scoped_refptr<Dispatcher>(SharedBufferDispatcher::Deserialize(
           channel, source, size, platform_handles));
+    case Type::WAIT_SET:
+      // Wait sets are never sent (see |MessagePipe|).
+      LOG(WARNING) << "Deserializing wait set";
+      return nullptr;
     case Type::PLATFORM_HANDLE:
       return scoped_refptr<Dispatcher>(PlatformHandleDispatcher::Deserialize(
           channel, source, size, platform_handles));
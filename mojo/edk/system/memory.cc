@@ -54,6 +54,8 @@ template void MOJO_SYSTEM_IMPL_EXPORT
 CheckUserPointerWithCount<8, 4>(const void*, size_t);
 template void MOJO_SYSTEM_IMPL_EXPORT
 CheckUserPointerWithCount<8, 8>(const void*, size_t);
+template void MOJO_SYSTEM_IMPL_EXPORT
+CheckUserPointerWithCount<24, 8>(const void*, size_t);
 
 template <size_t alignment>
 void CheckUserPointerWithSize(const void* pointer, size_t size) {
@@ -349,9 +349,14 @@ MojoResult MessagePipe::AttachTransportsNoLock(
   // respective handles simultaneously. The other case, of trying to write the
   // peer handle to a handle, doesn't make sense -- since no handle will be
   // available to read the message from.)
+  //
+  // Wait sets can't be sent either, since their members are registered with
+  // them by pointer.
   for (size_t i = 0; i < transports->size(); i++) {
     if (!(*transports)[i].is_valid())
       continue;
+    if ((*transports)[i].GetType() == Dispatcher::Type::WAIT_SET)
+      return MOJO_RESULT_INVALID_ARGUMENT;
     if ((*transports)[i].GetType() == Dispatcher::Type::MESSAGE_PIPE) {
       MessagePipeDispatcherTransport mp_transport((*transports)[i]);
       if (mp_transport.GetMessagePipe() == this) {
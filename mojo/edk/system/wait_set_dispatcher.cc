@@ -0,0 +1,240 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/edk/system/wait_set_dispatcher.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/logging.h"
+#include "base/time/time.h"
+#include "mojo/edk/system/awakable.h"
+#include "mojo/edk/system/handle_signals_state.h"
+
+namespace mojo {
+namespace system {
+
+// A member of the set. Its fields other than |ready| are immutable; |ready| is
+// protected by the owner's |ready_lock_| and is true while the member is on the
+// owner's ready list (and so is not registered with |dispatcher|).
+class WaitSetDispatcher::Member final : public Awakable {
+ public:
+  Member(WaitSetDispatcher* owner,
+         const scoped_refptr<Dispatcher>& dispatcher,
+         MojoHandleSignals signals,
+         uint64_t cookie)
+      : owner(owner),
+        dispatcher(dispatcher),
+        signals(signals),
+        cookie(cookie),
+        ready(false) {}
+
+  // Returns false, since the member moves to the ready list and stops waiting
+  // until |CollectReadyNoLock()| registers it again.
+  bool Awake(MojoResult /*result*/, uintptr_t /*context*/) override {
+    owner->OnMemberAwoken(this);
+    return false;
+  }
+
+  WaitSetDispatcher* const owner;
+  const scoped_refptr<Dispatcher> dispatcher;
+  const MojoHandleSignals signals;
+  const uint64_t cookie;
+  bool ready;
+
+ private:
+  MOJO_DISALLOW_COPY_AND_ASSIGN(Member);
+};
+
+Dispatcher::Type WaitSetDispatcher::GetType() const {
+  return Type::WAIT_SET;
+}
+
+MojoResult WaitSetDispatcher::Add(const scoped_refptr<Dispatcher>& dispatcher,
+                                  MojoHandleSignals signals,
+                                  uint64_t cookie) {
+  // Wait sets can't be waited on. (Adding one to itself would also deadlock.)
+  if (dispatcher->GetType() == Type::WAIT_SET)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  MutexLocker locker(&mutex());
+  {
+    base::AutoLock ready_locker(ready_lock_);
+    if (closed_)
+      return MOJO_RESULT_INVALID_ARGUMENT;
+  }
+  if (members_.find(cookie) != members_.end())
+    return MOJO_RESULT_ALREADY_EXISTS;
+
+  Member* member = new Member(this, dispatcher, signals, cookie);
+  MojoResult result = dispatcher->AddAwakable(member, signals, 0, nullptr);
+  if (result == MOJO_RESULT_INVALID_ARGUMENT) {
+    // |dispatcher| was closed after its handle was looked up.
+    delete member;
+    return MOJO_RESULT_INVALID_ARGUMENT;
+  }
+  members_[cookie] = member;
+  if (result != MOJO_RESULT_OK) {
+    // Already satisfied or unsatisfiable; the next |Wait()| will report it.
+    OnMemberAwoken(member);
+  }
+  return MOJO_RESULT_OK;
+}
+
+MojoResult WaitSetDispatcher::Remove(uint64_t cookie) {
+  MutexLocker locker(&mutex());
+  auto it = members_.find(cookie);
+  if (it == members_.end())
+    return MOJO_RESULT_NOT_FOUND;
+
+  Member* member = it->second;
+  members_.erase(it);
+  // After this, |member|'s awakable can't be called anymore.
+  member->dispatcher->RemoveAwakable(member, nullptr);
+  {
+    base::AutoLock ready_locker(ready_lock_);
+    if (member->ready)
+      ready_.erase(std::find(ready_.begin(), ready_.end(), member));
+  }
+  delete member;
+  return MOJO_RESULT_OK;
+}
+
+MojoResult WaitSetDispatcher::Wait(MojoDeadline deadline,
+                                   uint32_t max_results,
+                                   std::vector<MojoWaitSetResult>* results) {
+  DCHECK_GT(max_results, 0u);
+  DCHECK(results->empty());
+
+  // As in |Waiter::Wait()|, treat any out-of-range deadline as "forever".
+  const bool indefinite =
+      deadline > static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+  const base::TimeTicks end_time =
+      indefinite ? base::TimeTicks()
+                 : base::TimeTicks::Now() + base::TimeDelta::FromMicroseconds(
+                                                static_cast<int64_t>(deadline));
+  for (;;) {
+    {
+      MutexLocker locker(&mutex());
+      if (!CollectReadyNoLock(max_results, results))
+        return MOJO_RESULT_CANCELLED;
+    }
+    if (!results->empty())
+      return MOJO_RESULT_OK;
+
+    // Everything on the ready list turned out to be idle again (or the list was
+    // empty), so wait for another member to wake up.
+    base::AutoLock ready_locker(ready_lock_);
+    while (ready_.empty() && !closed_) {
+      if (indefinite) {
+        ready_cv_.Wait();
+      } else {
+        base::TimeTicks now_time = base::TimeTicks::Now();
+        if (now_time >= end_time)
+          return MOJO_RESULT_DEADLINE_EXCEEDED;
+        ready_cv_.TimedWait(end_time - now_time);
+      }
+    }
+    if (closed_)
+      return MOJO_RESULT_CANCELLED;
+  }
+}
+
+WaitSetDispatcher::WaitSetDispatcher()
+    : ready_cv_(&ready_lock_), closed_(false) {
+}
+
+WaitSetDispatcher::~WaitSetDispatcher() {
+  DCHECK(members_.empty());
+  DCHECK(ready_.empty());
+}
+
+void WaitSetDispatcher::OnMemberAwoken(Member* member) {
+  base::AutoLock locker(ready_lock_);
+  if (closed_ || member->ready)
+    return;
+  member->ready = true;
+  ready_.push_back(member);
+  ready_cv_.Signal();
+}
+
+bool WaitSetDispatcher::CollectReadyNoLock(
+    uint32_t max_results,
+    std::vector<MojoWaitSetResult>* results) {
+  mutex().AssertHeld();
+
+  // Take the whole ready list. The members are marked not ready before they
+  // are registered again, so that a wakeup right after registering isn't lost.
+  std::vector<Member*> ready;
+  {
+    base::AutoLock locker(ready_lock_);
+    if (closed_)
+      return false;
+    ready.swap(ready_);
+    for (Member* member : ready)
+      member->ready = false;
+  }
+
+  size_t num_checked = 0;
+  std::vector<Member*> still_ready;
+  for (; num_checked < ready.size() && results->size() < max_results;
+       num_checked++) {
+    Member* member = ready[num_checked];
+    HandleSignalsState state;
+    MojoResult result =
+        member->dispatcher->AddAwakable(member, member->signals, 0, &state);
+    if (result == MOJO_RESULT_OK)
+      continue;  // Idle again, and waiting.
+
+    MojoWaitSetResult wait_set_result = {};
+    wait_set_result.cookie = member->cookie;
+    if (result == MOJO_RESULT_ALREADY_EXISTS)
+      wait_set_result.wait_result = MOJO_RESULT_OK;
+    else if (result == MOJO_RESULT_INVALID_ARGUMENT)
+      wait_set_result.wait_result = MOJO_RESULT_CANCELLED;
+    else
+      wait_set_result.wait_result = result;
+    wait_set_result.signals_state = state;
+    results->push_back(wait_set_result);
+    still_ready.push_back(member);
+  }
+
+  // Members that didn't fit in |results| go first next time, then ones that
+  // woke up meanwhile, then the ones just reported.
+  base::AutoLock locker(ready_lock_);
+  ready_.insert(ready_.begin(), ready.begin() + num_checked, ready.end());
+  ready_.insert(ready_.end(), still_ready.begin(), still_ready.end());
+  for (size_t i = num_checked; i < ready.size(); i++)
+    ready[i]->ready = true;
+  for (Member* member : still_ready)
+    member->ready = true;
+  return true;
+}
+
+void WaitSetDispatcher::CancelAllAwakablesNoLock() {
+  mutex().AssertHeld();
+  base::AutoLock locker(ready_lock_);
+  closed_ = true;
+  ready_.clear();
+  ready_cv_.Broadcast();
+}
+
+void WaitSetDispatcher::CloseImplNoLock() {
+  mutex().AssertHeld();
+  for (const auto& it : members_) {
+    it.second->dispatcher->RemoveAwakable(it.second, nullptr);
+    delete it.second;
+  }
+  members_.clear();
+}
+
+scoped_refptr<Dispatcher>
+WaitSetDispatcher::CreateEquivalentDispatcherAndCloseImplNoLock() {
+  // |MessagePipe| refuses to send wait sets.
+  NOTREACHED();
+  return nullptr;
+}
+
+}  // namespace system
+}  // namespace mojo
@@ -0,0 +1,94 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_EDK_SYSTEM_WAIT_SET_DISPATCHER_H_
+#define MOJO_EDK_SYSTEM_WAIT_SET_DISPATCHER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "mojo/edk/system/dispatcher.h"
+#include "mojo/edk/system/system_impl_export.h"
+#include "mojo/public/c/system/wait_set.h"
+#include "mojo/public/cpp/system/macros.h"
+
+namespace mojo {
+namespace system {
+
+// The dispatcher behind |MojoCreateWaitSet()|. Each member of the set has its
+// own awakable, which stays registered with the member's dispatcher while the
+// member is not ready. When a member becomes ready its awakable moves it to a
+// ready list and unregisters; |Wait()| then only looks at the ready list, so
+// idle members cost nothing per wait.
+//
+// A member stays on the ready list for as long as it is ready: each |Wait()|
+// tries to re-register the awakables of the members it finds on the list, and
+// |Dispatcher::AddAwakable()| tells it (by failing) which of them are still
+// ready. Those are reported; the rest go back to waiting.
+//
+// Lock order: |mutex()| (held by |Add()|, |Remove()|, closing and the
+// non-blocking part of |Wait()|), then members' dispatcher mutexes, then
+// |ready_lock_| (taken by members' awakables, which are called under their
+// dispatcher's mutex).
+class MOJO_SYSTEM_IMPL_EXPORT WaitSetDispatcher final : public Dispatcher {
+ public:
+  static scoped_refptr<WaitSetDispatcher> Create() {
+    return make_scoped_refptr(new WaitSetDispatcher());
+  }
+
+  // |Dispatcher| public methods:
+  Type GetType() const override;
+
+  // These implement |MojoWaitSetAdd()|, |MojoWaitSetRemove()| and
+  // |MojoWaitSetWait()|. |Wait()| appends at most |max_results| entries to
+  // |*results|, which must be empty.
+  MojoResult Add(const scoped_refptr<Dispatcher>& dispatcher,
+                 MojoHandleSignals signals,
+                 uint64_t cookie);
+  MojoResult Remove(uint64_t cookie);
+  MojoResult Wait(MojoDeadline deadline,
+                  uint32_t max_results,
+                  std::vector<MojoWaitSetResult>* results);
+
+ private:
+  class Member;
+
+  WaitSetDispatcher();
+  ~WaitSetDispatcher() override;
+
+  // Called by a registered |Member|'s awakable, under the lock of the member's
+  // dispatcher.
+  void OnMemberAwoken(Member* member);
+
+  // Reports up to |max_results| ready members, re-registering those that are
+  // no longer ready. Returns false if the wait set has been closed.
+  bool CollectReadyNoLock(uint32_t max_results,
+                          std::vector<MojoWaitSetResult>* results)
+      MOJO_EXCLUSIVE_LOCKS_REQUIRED(mutex());
+
+  // |Dispatcher| protected methods:
+  void CancelAllAwakablesNoLock() override;
+  void CloseImplNoLock() override;
+  scoped_refptr<Dispatcher> CreateEquivalentDispatcherAndCloseImplNoLock()
+      override;
+
+  // Owns the members.
+  std::map<uint64_t, Member*> members_ MOJO_GUARDED_BY(mutex());
+
+  base::Lock ready_lock_;  // Protects the following members.
+  base::ConditionVariable ready_cv_;  // Associated to |ready_lock_|.
+  std::vector<Member*> ready_;
+  bool closed_;
+
+  MOJO_DISALLOW_COPY_AND_ASSIGN(WaitSetDispatcher);
+};
+
+}  // namespace system
+}  // namespace mojo
+
+#endif  // MOJO_EDK_SYSTEM_WAIT_SET_DISPATCHER_H_
@@ -0,0 +1,224 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/edk/system/wait_set_dispatcher.h"
+
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/threading/simple_thread.h"
+#include "mojo/edk/system/message_pipe.h"
+#include "mojo/edk/system/message_pipe_dispatcher.h"
+#include "mojo/edk/system/test_utils.h"
+#include "mojo/public/cpp/system/macros.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace system {
+namespace {
+
+void CreatePipe(scoped_refptr<MessagePipeDispatcher>* d0,
+                scoped_refptr<MessagePipeDispatcher>* d1) {
+  *d0 = MessagePipeDispatcher::Create(
+      MessagePipeDispatcher::kDefaultCreateOptions);
+  *d1 = MessagePipeDispatcher::Create(
+      MessagePipeDispatcher::kDefaultCreateOptions);
+  scoped_refptr<MessagePipe> mp(MessagePipe::CreateLocalLocal());
+  (*d0)->Init(mp, 0);
+  (*d1)->Init(mp, 1);
+}
+
+void WriteOneByte(MessagePipeDispatcher* dispatcher) {
+  char byte = 'x';
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dispatcher->WriteMessage(UserPointer<const void>(&byte), 1u,
+                                     nullptr, MOJO_WRITE_MESSAGE_FLAG_NONE));
+}
+
+void ReadOneByte(MessagePipeDispatcher* dispatcher) {
+  char byte = 0;
+  uint32_t num_bytes = 1u;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dispatcher->ReadMessage(UserPointer<void>(&byte),
+                                    MakeUserPointer(&num_bytes), nullptr,
+                                    nullptr, MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ('x', byte);
+}
+
+TEST(WaitSetDispatcherTest, Basic) {
+  scoped_refptr<WaitSetDispatcher> wait_set = WaitSetDispatcher::Create();
+  EXPECT_EQ(Dispatcher::Type::WAIT_SET, wait_set->GetType());
+
+  scoped_refptr<MessagePipeDispatcher> a0, a1, b0, b1;
+  CreatePipe(&a0, &a1);
+  CreatePipe(&b0, &b1);
+  EXPECT_EQ(MOJO_RESULT_OK,
+            wait_set->Add(a0, MOJO_HANDLE_SIGNAL_READABLE, 1u));
+  EXPECT_EQ(MOJO_RESULT_OK,
+            wait_set->Add(b0, MOJO_HANDLE_SIGNAL_READABLE, 2u));
+  EXPECT_EQ(MOJO_RESULT_ALREADY_EXISTS,
+            wait_set->Add(b1, MOJO_HANDLE_SIGNAL_READABLE, 2u));
+
+  std::vector<MojoWaitSetResult> results;
+  EXPECT_EQ(MOJO_RESULT_DEADLINE_EXCEEDED, wait_set->Wait(0, 10u, &results));
+  EXPECT_TRUE(results.empty());
+
+  WriteOneByte(b1.get());
+  ASSERT_EQ(MOJO_RESULT_OK,
+            wait_set->Wait(MOJO_DEADLINE_INDEFINITE, 10u, &results));
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(2u, results[0].cookie);
+  EXPECT_EQ(MOJO_RESULT_OK, results[0].wait_result);
+  EXPECT_TRUE(results[0].signals_state.satisfied_signals &
+              MOJO_HANDLE_SIGNAL_READABLE);
+
+  // Still readable, so it's reported again.
+  results.clear();
+  ASSERT_EQ(MOJO_RESULT_OK, wait_set->Wait(0, 10u, &results));
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(2u, results[0].cookie);
+
+  // Once read, it goes back to waiting.
+  ReadOneByte(b0.get());
+  results.clear();
+  EXPECT_EQ(MOJO_RESULT_DEADLINE_EXCEEDED, wait_set->Wait(0, 10u, &results));
+
+  WriteOneByte(a1.get());
+  WriteOneByte(b1.get());
+  results.clear();
+  ASSERT_EQ(MOJO_RESULT_OK, wait_set->Wait(0, 10u, &results));
+  EXPECT_EQ(2u, results.size());
+
+  EXPECT_EQ(MOJO_RESULT_OK, wait_set->Close());
+  EXPECT_EQ(MOJO_RESULT_OK, a0->Close());
+  EXPECT_EQ(MOJO_RESULT_OK, a1->Close());
+  EXPECT_EQ(MOJO_RESULT_OK, b0->Close());
+  EXPECT_EQ(MOJO_RESULT_OK, b1->Close());
+}
+
+TEST(WaitSetDispatcherTest, LeftOverResultsComeFirst) {
+  scoped_refptr<WaitSetDispatcher> wait_set = WaitSetDispatcher::Create();
+  scoped_refptr<MessagePipeDispatcher> d0[3], d1[3];
+  for (uint64_t i = 0; i < 3u; i++) {
+    CreatePipe(&d0[i], &d1[i]);
+    EXPECT_EQ(MOJO_RESULT_OK,
+              wait_set->Add(d0[i], MOJO_HANDLE_SIGNAL_READABLE, i));
+    WriteOneByte(d1[i].get());
+  }
+
+  std::vector<MojoWaitSetResult> results;
+  ASSERT_EQ(MOJO_RESULT_OK, wait_set->Wait(0, 2u, &results));
+  ASSERT_EQ(2u, results.size());
+  uint64_t reported = results[0].cookie + results[1].cookie;
+
+  // The member that didn't fit is reported first.
+  results.clear();
+  ASSERT_EQ(MOJO_RESULT_OK, wait_set->Wait(0, 2u, &results));
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(0u + 1u + 2u - reported, results[0].cookie);
+
+  EXPECT_EQ(MOJO_RESULT_OK, wait_set->Close());
+  for (size_t i = 0; i < 3u; i++) {
+    EXPECT_EQ(MOJO_RESULT_OK, d0[i]->Close());
+    EXPECT_EQ(MOJO_RESULT_OK, d1[i]->Close());
+  }
+}
+
+TEST(WaitSetDispatcherTest, ClosedAndUnsatisfiableMembers) {
+  scoped_refptr<WaitSetDispatcher> wait_set = WaitSetDispatcher::Create();
+  scoped_refptr<MessagePipeDispatcher> d0, d1;
+  CreatePipe(&d0, &d1);
+  EXPECT_EQ(MOJO_RESULT_OK,
+            wait_set->Add(d0, MOJO_HANDLE_SIGNAL_READABLE, 1u));
+  EXPECT_EQ(MOJO_RESULT_OK,
+            wait_set->Add(d1, MOJO_HANDLE_SIGNAL_READABLE, 2u));
+
+  // Closing |d0| cancels its member, and makes |d1| unreadable forever.
+  EXPECT_EQ(MOJO_RESULT_OK, d0->Close());
+  std::vector<MojoWaitSetResult> results;
+  ASSERT_EQ(MOJO_RESULT_OK, wait_set->Wait(0, 10u, &results));
+  ASSERT_EQ(2u, results.size());
+  for (const MojoWaitSetResult& result : results) {
+    if (result.cookie == 1u)
+      EXPECT_EQ(MOJO_RESULT_CANCELLED, result.wait_result);
+    else
+      EXPECT_EQ(MOJO_RESULT_FAILED_PRECONDITION, result.wait_result);
+  }
+
+  EXPECT_EQ(MOJO_RESULT_OK, wait_set->Remove(1u));
+  EXPECT_EQ(MOJO_RESULT_NOT_FOUND, wait_set->Remove(1u));
+  EXPECT_EQ(MOJO_RESULT_OK, wait_set->Remove(2u));
+  results.clear();
+  EXPECT_EQ(MOJO_RESULT_DEADLINE_EXCEEDED, wait_set->Wait(0, 10u, &results));
+
+  EXPECT_EQ(MOJO_RESULT_INVALID_ARGUMENT,
+            wait_set->Add(wait_set, MOJO_HANDLE_SIGNAL_READABLE, 3u));
+
+  EXPECT_EQ(MOJO_RESULT_OK, wait_set->Close());
+  EXPECT_EQ(MOJO_RESULT_OK, d1->Close());
+}
+
+// Waits on a wait set (indefinitely) on its own thread.
+class WaitThread : public base::SimpleThread {
+ public:
+  // |*result| and |*results| belong to this object until it is destroyed.
+  WaitThread(WaitSetDispatcher* wait_set,
+             MojoResult* result,
+             std::vector<MojoWaitSetResult>* results)
+      : base::SimpleThread("wait_thread"),
+        wait_set_(wait_set),
+        result_(result),
+        results_(results) {
+    *result_ = MOJO_RESULT_INTERNAL;
+  }
+  ~WaitThread() override { Join(); }
+
+ private:
+  void Run() override {
+    *result_ = wait_set_->Wait(MOJO_DEADLINE_INDEFINITE, 10u, results_);
+  }
+
+  WaitSetDispatcher* const wait_set_;
+  MojoResult* const result_;
+  std::vector<MojoWaitSetResult>* const results_;
+
+  MOJO_DISALLOW_COPY_AND_ASSIGN(WaitThread);
+};
+
+TEST(WaitSetDispatcherTest, WakesUpWaiter) {
+  scoped_refptr<WaitSetDispatcher> wait_set = WaitSetDispatcher::Create();
+  scoped_refptr<MessagePipeDispatcher> d0, d1;
+  CreatePipe(&d0, &d1);
+  EXPECT_EQ(MOJO_RESULT_OK,
+            wait_set->Add(d0, MOJO_HANDLE_SIGNAL_READABLE, 7u));
+
+  MojoResult result;
+  std::vector<MojoWaitSetResult> results;
+  {
+    WaitThread thread(wait_set.get(), &result, &results);
+    thread.Start();
+    test::Sleep(2 * test::EpsilonDeadline());
+    WriteOneByte(d1.get());
+  }  // Joins the thread.
+  EXPECT_EQ(MOJO_RESULT_OK, result);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(7u, results[0].cookie);
+
+  ReadOneByte(d0.get());
+  results.clear();
+  {
+    WaitThread thread(wait_set.get(), &result, &results);
+    thread.Start();
+    test::Sleep(2 * test::EpsilonDeadline());
+    EXPECT_EQ(MOJO_RESULT_OK, wait_set->Close());
+  }  // Joins the thread.
+  EXPECT_EQ(MOJO_RESULT_CANCELLED, result);
+
+  EXPECT_EQ(MOJO_RESULT_OK, d0->Close());
+  EXPECT_EQ(MOJO_RESULT_OK, d1->Close());
+}
+
+}  // namespace
+}  // namespace system
+}  // namespace mojo
@@ -0,0 +1,113 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file contains types/constants and functions specific to wait sets.
+//
+// Note: This header should be compilable as C.
+
+#ifndef MOJO_PUBLIC_C_SYSTEM_WAIT_SET_H_
+#define MOJO_PUBLIC_C_SYSTEM_WAIT_SET_H_
+
+#include "mojo/public/c/system/macros.h"
+#include "mojo/public/c/system/system_export.h"
+#include "mojo/public/c/system/types.h"
+
+// |MojoWaitSetResult|: Returned by |MojoWaitSetWait()| for each member of a
+// wait set that is ready. Members are as follows:
+//   - |cookie|: The cookie given to |MojoWaitSetAdd()| for the member.
+//   - |wait_result|: |MOJO_RESULT_OK| if the member's signals are satisfied,
+//         |MOJO_RESULT_FAILED_PRECONDITION| if they can never be satisfied and
+//         |MOJO_RESULT_CANCELLED| if the member's handle was closed.
+//   - |reserved|: Always set to zero.
+//   - |signals_state|: The member's signals state when it was found ready.
+
+MOJO_STATIC_ASSERT(MOJO_ALIGNOF(int64_t) == 8, "int64_t has weird alignment");
+struct MOJO_ALIGNAS(8) MojoWaitSetResult {
+  uint64_t cookie;
+  MojoResult wait_result;
+  uint32_t reserved;
+  struct MojoHandleSignalsState signals_state;
+};
+MOJO_STATIC_ASSERT(sizeof(MojoWaitSetResult) == 24,
+                   "MojoWaitSetResult has wrong size");
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Note: See the comment in functions.h about the meaning of the "optional"
+// label for pointer parameters.
+
+// Creates a wait set: a set of handles, each with the signals it is waited on
+// for, that stays registered with the handles between waits. Unlike
+// |MojoWaitMany()|, waiting on a wait set costs time proportional to the number
+// of members that are ready, not to the number of members. A wait set handle
+// cannot be sent over a message pipe, added to a wait set or waited on with
+// |MojoWait()|/|MojoWaitMany()|.
+//
+// On success, |*wait_set_handle| is set to the new wait set's handle.
+//
+// Returns:
+//   |MOJO_RESULT_OK| on success.
+//   |MOJO_RESULT_RESOURCE_EXHAUSTED| if a process/system/quota/etc. limit has
+//       been reached.
+//   |MOJO_RESULT_UNIMPLEMENTED| if the embedder predates wait sets. The other
+//       wait set functions also return this then.
+MOJO_SYSTEM_EXPORT MojoResult
+    MojoCreateWaitSet(MojoHandle* wait_set_handle);  // Out.
+
+// Adds |handle| to the wait set |wait_set_handle|, to be reported by
+// |MojoWaitSetWait()| (with the given |cookie|) whenever |signals| are
+// satisfied or become unsatisfiable. The wait set does not own |handle|; if
+// |handle| is closed, the member is reported with |MOJO_RESULT_CANCELLED| until
+// it is removed.
+//
+// Returns:
+//   |MOJO_RESULT_OK| on success.
+//   |MOJO_RESULT_INVALID_ARGUMENT| if |wait_set_handle| is not a valid wait set
+//       handle or |handle| is not a valid handle (or is a wait set handle).
+//   |MOJO_RESULT_ALREADY_EXISTS| if the wait set already has a member with the
+//       given |cookie|.
+MOJO_SYSTEM_EXPORT MojoResult MojoWaitSetAdd(MojoHandle wait_set_handle,
+                                             MojoHandle handle,
+                                             MojoHandleSignals signals,
+                                             uint64_t cookie);
+
+// Removes the member with the given |cookie| from the wait set
+// |wait_set_handle|. This is valid whether or not the member's handle is still
+// open.
+//
+// Returns:
+//   |MOJO_RESULT_OK| on success.
+//   |MOJO_RESULT_INVALID_ARGUMENT| if |wait_set_handle| is not a valid wait set
+//       handle.
+//   |MOJO_RESULT_NOT_FOUND| if there is no member with the given |cookie|.
+MOJO_SYSTEM_EXPORT MojoResult MojoWaitSetRemove(MojoHandle wait_set_handle,
+                                                uint64_t cookie);
+
+// Waits until at least one member of the wait set |wait_set_handle| is ready or
+// until |deadline| has passed, then reports as many ready members as fit in
+// |results|. On input |*num_results| must be set to the size of the |results|
+// array; on success it is set to the number of entries written. Readiness is
+// level-triggered: a member stays ready (and is reported by every wait) for as
+// long as its signals remain satisfied. If there are more ready members than
+// fit in |results|, later waits report the ones that were left out first.
+//
+// Returns:
+//   |MOJO_RESULT_OK| if at least one member was reported.
+//   |MOJO_RESULT_INVALID_ARGUMENT| if |wait_set_handle| is not a valid wait set
+//       handle or |*num_results| is zero.
+//   |MOJO_RESULT_DEADLINE_EXCEEDED| if no member was ready before |deadline|.
+//   |MOJO_RESULT_CANCELLED| if |wait_set_handle| was closed during the wait.
+MOJO_SYSTEM_EXPORT MojoResult
+    MojoWaitSetWait(MojoHandle wait_set_handle,
+                    MojoDeadline deadline,
+                    uint32_t* num_results,               // In/out.
+                    struct MojoWaitSetResult* results);  // Out.
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // MOJO_PUBLIC_C_SYSTEM_WAIT_SET_H_
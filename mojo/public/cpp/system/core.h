@@ -11,5 +11,6 @@
 #include "mojo/public/cpp/system/handle.h"
 #include "mojo/public/cpp/system/macros.h"
 #include "mojo/public/cpp/system/message_pipe.h"
+#include "mojo/public/cpp/system/wait_set.h"
 
 #endif  // MOJO_PUBLIC_CPP_SYSTEM_CORE_H_
@@ -19,6 +19,87 @@ class MojoMessagePipeReadResult {
   }
 }
 
+// A batch of messages packed into one ByteData, as read by
+// MojoMessagePipeEndpoint.readAll() or written by
+// MojoMessagePipeEndpoint.writeAll(). The buffers grow as needed and are meant
+// to be reused, so that reading or writing a batch costs one call into native
+// code and no per-message allocation.
+class MojoMessageBatch {
+  ByteData bytes;
+  // For message i, ends[2 * i] is the end offset of its bytes and
+  // ends[2 * i + 1] the end index of its handles.
+  Uint32List ends;
+  Uint32List handles;
+  int length = 0;
+
+  MojoMessageBatch([int bytesCapacity = 1024, int messagesCapacity = 16])
+      : bytes = new ByteData(bytesCapacity),
+        ends = new Uint32List(2 * messagesCapacity),
+        handles = new Uint32List(messagesCapacity);
+
+  int _bytesStart(int i) => (i == 0) ? 0 : ends[2 * i - 2];
+  int _handlesStart(int i) => (i == 0) ? 0 : ends[2 * i - 1];
+
+  ByteData messageData(int i) {
+    int start = _bytesStart(i);
+    return new ByteData.view(
+        bytes.buffer, bytes.offsetInBytes + start, ends[2 * i] - start);
+  }
+
+  List<MojoHandle> messageHandles(int i) {
+    int start = _handlesStart(i);
+    return new List<MojoHandle>.generate(ends[2 * i + 1] - start,
+        (j) => new MojoHandle(handles[start + j]));
+  }
+
+  void add(ByteData data, [List<MojoHandle> messageHandles = null]) {
+    int numBytes = (data == null) ? 0 : data.lengthInBytes;
+    int numHandles = (messageHandles == null) ? 0 : messageHandles.length;
+    int bytesStart = _bytesStart(length);
+    int handlesStart = _handlesStart(length);
+
+    if (bytesStart + numBytes > bytes.lengthInBytes) {
+      var grown = new ByteData(_grownLength(bytes.lengthInBytes,
+                                            bytesStart + numBytes));
+      new Uint8List.view(grown.buffer).setAll(0,
+          new Uint8List.view(bytes.buffer, bytes.offsetInBytes, bytesStart));
+      bytes = grown;
+    }
+    ends = _grow(ends, 2 * length, 2 * length + 2);
+    handles = _grow(handles, handlesStart, handlesStart + numHandles);
+
+    if (numBytes > 0) {
+      new Uint8List.view(bytes.buffer, bytes.offsetInBytes + bytesStart)
+          .setAll(0, new Uint8List.view(data.buffer, data.offsetInBytes,
+                                        numBytes));
+    }
+    for (int j = 0; j < numHandles; j++) {
+      handles[handlesStart + j] = messageHandles[j].h;
+    }
+    ends[2 * length] = bytesStart + numBytes;
+    ends[2 * length + 1] = handlesStart + numHandles;
+    length++;
+  }
+
+  void clear() {
+    length = 0;
+  }
+
+  static int _grownLength(int length, int needed) =>
+      (needed > 2 * length) ? needed : 2 * length;
+
+  static Uint32List _grow(Uint32List list, int used, int needed) {
+    if (needed <= list.length) {
+      return list;
+    }
+    var grown = new Uint32List(_grownLength(list.length, needed));
+    grown.setRange(0, used, list);
+    return grown;
+  }
+
+  String toString() => "MojoMessageBatch(length: $length)";
+}
+
 class MojoMessagePipeEndpoint {
   static const int WRITE_FLAG_NONE = 0;
   static const int READ_FLAG_NONE = 0;
@@ -109,6 +190,53 @@ class MojoMessagePipeEndpoint {
 
   MojoMessagePipeReadResult query() => read(null);
 
+  // Reads all the messages pending on the pipe into |batch|, replacing its
+  // contents, and returns how many were read. If none were, |status| says why
+  // (e.g. SHOULD_WAIT).
+  int readAll(MojoMessageBatch batch) {
+    batch.clear();
+    if (handle == null) {
+      status = MojoResult.INVALID_ARGUMENT;
+      return 0;
+    }
+
+    List result = MojoMessagePipeNatives.MojoReadAllMessages(
+        handle.h, batch.bytes, batch.ends, batch.handles);
+    if (result == null) {
+      status = MojoResult.INVALID_ARGUMENT;
+      return 0;
+    }
+
+    assert((result is List) && (result.length == 5));
+    status = new MojoResult(result[0]);
+    batch.length = result[1];
+    batch.bytes = result[2];
+    batch.ends = result[3];
+    batch.handles = result[4];
+    return batch.length;
+  }
+
+  // Writes the messages in |batch| in order, stopping at the first failure, and
+  // returns how many were written. The handles of the messages that weren't
+  // written are still owned by the caller.
+  int writeAll(MojoMessageBatch batch) {
+    if (handle == null) {
+      status = MojoResult.INVALID_ARGUMENT;
+      return 0;
+    }
+
+    List result = MojoMessagePipeNatives.MojoWriteAllMessages(
+        handle.h, batch.bytes, batch.ends, batch.handles, batch.length);
+    if (result == null) {
+      status = MojoResult.INVALID_ARGUMENT;
+      return 0;
+    }
+
+    assert((result is List) && (result.length == 2));
+    status = new MojoResult(result[0]);
+    return result[1];
+  }
+
   bool setDescription(String description) {
     assert(MojoHandle._setHandleLeakDescription(handle, description));
     return true;
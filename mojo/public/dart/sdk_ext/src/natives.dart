@@ -32,6 +32,12 @@ class MojoMessagePipeNatives {
 
   static List MojoReadMessage(int handle, ByteData data, int numBytes,
       List<int> handles, int flags) native "MojoMessagePipe_Read";
+
+  static List MojoReadAllMessages(int handle, ByteData data, Uint32List ends,
+      Uint32List handles) native "MojoMessagePipe_ReadAll";
+
+  static List MojoWriteAllMessages(int handle, ByteData data, Uint32List ends,
+      Uint32List handles, int numMessages) native "MojoMessagePipe_WriteAll";
 }
 
 class MojoDataPipeNatives {
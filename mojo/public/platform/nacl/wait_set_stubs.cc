@@ -0,0 +1,32 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The NaCl IRT doesn't provide wait sets yet. These stand in for the missing
+// syscalls so that callers can detect that and fall back to MojoWaitMany().
+// TODO: Generate these with the rest of libmojo.cc once |nacl_irt_mojo| has
+// wait set entries.
+
+#include "mojo/public/c/system/wait_set.h"
+
+MojoResult MojoCreateWaitSet(MojoHandle* wait_set_handle) {
+  return MOJO_RESULT_UNIMPLEMENTED;
+}
+
+MojoResult MojoWaitSetAdd(MojoHandle wait_set_handle,
+                          MojoHandle handle,
+                          MojoHandleSignals signals,
+                          uint64_t cookie) {
+  return MOJO_RESULT_UNIMPLEMENTED;
+}
+
+MojoResult MojoWaitSetRemove(MojoHandle wait_set_handle, uint64_t cookie) {
+  return MOJO_RESULT_UNIMPLEMENTED;
+}
+
+MojoResult MojoWaitSetWait(MojoHandle wait_set_handle,
+                           MojoDeadline deadline,
+                           uint32_t* num_results,
+                           struct MojoWaitSetResult* results) {
+  return MOJO_RESULT_UNIMPLEMENTED;
+}
@@ -5,6 +5,7 @@
 #include "mojo/public/platform/native/system_thunks.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include "mojo/public/platform/native/thunk_export.h"
 
@@ -158,10 +159,46 @@ MojoResult MojoUnmapBuffer(void* buffer) {
   return g_thunks.UnmapBuffer(buffer);
 }
 
+MojoResult MojoCreateWaitSet(MojoHandle* wait_set_handle) {
+  if (!g_thunks.CreateWaitSet)
+    return MOJO_RESULT_UNIMPLEMENTED;
+  return g_thunks.CreateWaitSet(wait_set_handle);
+}
+
+MojoResult MojoWaitSetAdd(MojoHandle wait_set_handle,
+                          MojoHandle handle,
+                          MojoHandleSignals signals,
+                          uint64_t cookie) {
+  if (!g_thunks.WaitSetAdd)
+    return MOJO_RESULT_UNIMPLEMENTED;
+  return g_thunks.WaitSetAdd(wait_set_handle, handle, signals, cookie);
+}
+
+MojoResult MojoWaitSetRemove(MojoHandle wait_set_handle, uint64_t cookie) {
+  if (!g_thunks.WaitSetRemove)
+    return MOJO_RESULT_UNIMPLEMENTED;
+  return g_thunks.WaitSetRemove(wait_set_handle, cookie);
+}
+
+MojoResult MojoWaitSetWait(MojoHandle wait_set_handle,
+                           MojoDeadline deadline,
+                           uint32_t* num_results,
+                           struct MojoWaitSetResult* results) {
+  if (!g_thunks.WaitSetWait)
+    return MOJO_RESULT_UNIMPLEMENTED;
+  return g_thunks.WaitSetWait(wait_set_handle, deadline, num_results, results);
+}
+
 extern "C" THUNK_EXPORT size_t MojoSetSystemThunks(
     const MojoSystemThunks* system_thunks) {
-  if (system_thunks->size >= sizeof(g_thunks))
-    g_thunks = *system_thunks;
+  // An older embedder's table ends before the functions that were appended
+  // since, which are left null.
+  if (system_thunks->size >= MOJO_SYSTEM_THUNKS_MINIMUM_SIZE) {
+    size_t size = system_thunks->size < sizeof(g_thunks) ? system_thunks->size
+                                                          : sizeof(g_thunks);
+    memset(&g_thunks, 0, sizeof(g_thunks));
+    memcpy(&g_thunks, system_thunks, size);
+  }
   return sizeof(g_thunks);
 }
 
@@ -23,16 +23,18 @@
 // MojoSystemThunks system_thunks = MojoMakeSystemThunks();
 // size_t expected_size = mojo_set_system_thunks_fn(&system_thunks);
 // if (expected_size > sizeof(MojoSystemThunks)) {
-//   LOG(ERROR)
-//       << "Invalid DSO. Expected MojoSystemThunks size: "
-//       << expected_size;
-//   break;
+//   LOG(WARNING)
+//       << "DSO expects a newer MojoSystemThunks of size " << expected_size
+//       << "; the functions it adds are unavailable.";
 // }
 
 // Structure used to bind the basic Mojo Core functions of a DSO to those of
 // the embedder.
 // This is the ABI between the embedder and the DSO. It can only have new
-// functions added to the end. No other changes are supported.
+// functions added to the end. No other changes are supported. A DSO accepts a
+// smaller table from an older embedder, as long as it has at least
+// |MOJO_SYSTEM_THUNKS_MINIMUM_SIZE| bytes; the missing functions return
+// |MOJO_RESULT_UNIMPLEMENTED|.
 #pragma pack(push, 8)
 struct MojoSystemThunks {
   size_t size;  // Should be set to sizeof(MojoSystemThunks).
@@ -101,9 +103,24 @@ struct MojoSystemThunks {
                           void** buffer,
                           MojoMapBufferFlags flags);
   MojoResult (*UnmapBuffer)(void* buffer);
+  // Added after the table above. Null if the embedder's table ends earlier.
+  MojoResult (*CreateWaitSet)(MojoHandle* wait_set_handle);
+  MojoResult (*WaitSetAdd)(MojoHandle wait_set_handle,
+                           MojoHandle handle,
+                           MojoHandleSignals signals,
+                           uint64_t cookie);
+  MojoResult (*WaitSetRemove)(MojoHandle wait_set_handle, uint64_t cookie);
+  MojoResult (*WaitSetWait)(MojoHandle wait_set_handle,
+                            MojoDeadline deadline,
+                            uint32_t* num_results,
+                            struct MojoWaitSetResult* results);
 };
 #pragma pack(pop)
 
+// The size of the table before any functions were appended to it.
+#define MOJO_SYSTEM_THUNKS_MINIMUM_SIZE \
+  offsetof(struct MojoSystemThunks, CreateWaitSet)
+
 
 #ifdef __cplusplus
 // Intended to be called from the embedder. Returns a |MojoCore| initialized
@@ -127,7 +144,11 @@ inline MojoSystemThunks MojoMakeSystemThunks() {
                                     MojoCreateSharedBuffer,
                                     MojoDuplicateBufferHandle,
                                     MojoMapBuffer,
-                                    MojoUnmapBuffer};
+                                    MojoUnmapBuffer,
+                                    MojoCreateWaitSet,
+                                    MojoWaitSetAdd,
+                                    MojoWaitSetRemove,
+                                    MojoWaitSetWait};
   return system_thunks;
 }
 #endif
@@ -139,7 +160,9 @@ inline MojoSystemThunks MojoMakeSystemThunks() {
 //     reinterpret_cast<MojoSetSystemThunksFn>(app_library.GetFunctionPointer(
 //         "MojoSetSystemThunks"));
 // The expected size of |system_thunks} is returned.
-// The contents of |system_thunks| are copied.
+// The contents of |system_thunks| are copied, up to the smaller of the two
+// sizes. They are ignored if |system_thunks->size| is less than
+// |MOJO_SYSTEM_THUNKS_MINIMUM_SIZE|.
 typedef size_t (*MojoSetSystemThunksFn)(
     const struct MojoSystemThunks* system_thunks);
 
@@ -0,0 +1,132 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the latency from PostTask() on one thread to the task running on a
+// MessagePumpMojo thread, for the MessageLoop's own task runner and for a
+// LockFreeTaskRunner, with several threads posting at once.
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "mojo/common/lock_free_task_runner.h"
+#include "mojo/common/message_pump_mojo.h"
+#include "mojo/public/cpp/test_support/test_support.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace test {
+namespace {
+
+const int kTasksPerProducer = 20000;
+
+// Lives on the consumer thread; only touched by tasks running there.
+class LatencyRecorder {
+ public:
+  explicit LatencyRecorder(int expected_tasks)
+      : expected_tasks_(expected_tasks), done_(false, false) {}
+
+  void Record(base::TimeTicks posted) {
+    latencies_.push_back(static_cast<double>(
+        (base::TimeTicks::Now() - posted).InMicroseconds()));
+    if (static_cast<int>(latencies_.size()) == expected_tasks_)
+      done_.Signal();
+  }
+
+  void Wait() { done_.Wait(); }
+
+  void Report(const char* test_name) {
+    std::sort(latencies_.begin(), latencies_.end());
+    double sum = 0;
+    for (double latency : latencies_)
+      sum += latency;
+    LogPerfResult(test_name, "Avg", sum / latencies_.size(), "us/task");
+    LogPerfResult(test_name, "P50", latencies_[latencies_.size() / 2],
+                  "us/task");
+    LogPerfResult(test_name, "P99", latencies_[latencies_.size() * 99 / 100],
+                  "us/task");
+  }
+
+ private:
+  int expected_tasks_;
+  std::vector<double> latencies_;
+  base::WaitableEvent done_;
+};
+
+void PostTasks(scoped_refptr<base::SingleThreadTaskRunner> target,
+               LatencyRecorder* recorder) {
+  for (int i = 0; i < kTasksPerProducer; ++i) {
+    target->PostTask(FROM_HERE,
+                     base::Bind(&LatencyRecorder::Record,
+                                base::Unretained(recorder),
+                                base::TimeTicks::Now()));
+  }
+}
+
+scoped_ptr<base::MessagePump> CreatePump(
+    scoped_refptr<common::LockFreeTaskRunner> task_runner) {
+  scoped_ptr<common::MessagePumpMojo> pump(new common::MessagePumpMojo);
+  if (task_runner)
+    pump->SetTaskRunner(task_runner);
+  return pump.Pass();
+}
+
+void Measure(const char* test_name, int producers, bool lock_free) {
+  scoped_refptr<common::LockFreeTaskRunner> lock_free_runner;
+  if (lock_free)
+    lock_free_runner = new common::LockFreeTaskRunner;
+
+  base::Thread consumer("consumer");
+  base::Thread::Options options;
+  options.message_pump_factory = base::Bind(&CreatePump, lock_free_runner);
+  consumer.StartWithOptions(options);
+  consumer.WaitUntilThreadStarted();
+
+  scoped_refptr<base::SingleThreadTaskRunner> target = consumer.task_runner();
+  if (lock_free_runner) {
+    lock_free_runner->SetDelayedTaskRunner(target);
+    target = lock_free_runner;
+  }
+
+  LatencyRecorder recorder(producers * kTasksPerProducer);
+  ScopedVector<base::Thread> threads;
+  for (int i = 0; i < producers; ++i)
+    threads.push_back(new base::Thread("producer"));
+  for (base::Thread* thread : threads)
+    thread->Start();
+  for (base::Thread* thread : threads) {
+    thread->task_runner()->PostTask(
+        FROM_HERE, base::Bind(&PostTasks, target, &recorder));
+  }
+
+  recorder.Wait();
+  threads.clear();
+  consumer.Stop();
+  recorder.Report(test_name);
+}
+
+TEST(LockFreeTaskRunnerPerfTest, MessageLoop1Producer) {
+  Measure(__FUNCTION__, 1, false);
+}
+
+TEST(LockFreeTaskRunnerPerfTest, LockFree1Producer) {
+  Measure(__FUNCTION__, 1, true);
+}
+
+TEST(LockFreeTaskRunnerPerfTest, MessageLoop4Producers) {
+  Measure(__FUNCTION__, 4, false);
+}
+
+TEST(LockFreeTaskRunnerPerfTest, LockFree4Producers) {
+  Measure(__FUNCTION__, 4, true);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace mojo
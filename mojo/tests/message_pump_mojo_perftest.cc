@@ -0,0 +1,134 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the cost of a message going through a MessagePumpMojo while the pump
+// also watches a number of idle message pipes. With the pump waiting on a wait
+// set, the per-message cost should not depend on the number of idle pipes.
+
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "mojo/common/message_pump_mojo.h"
+#include "mojo/common/message_pump_mojo_handler.h"
+#include "mojo/public/cpp/system/core.h"
+#include "mojo/public/cpp/test_support/test_support.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace test {
+namespace {
+
+const int kMessages = 20000;
+
+// Never notified, since nothing is written to the idle pipes.
+class IdleHandler : public common::MessagePumpMojoHandler {
+ public:
+  IdleHandler() {}
+
+  void OnHandleReady(const Handle& handle) override { NOTREACHED(); }
+  void OnHandleError(const Handle& handle, MojoResult result) override {
+    NOTREACHED();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(IdleHandler);
+};
+
+// Reads each message and writes the next one to the same pipe, so that every
+// message costs one wakeup of the pump.
+class PingHandler : public common::MessagePumpMojoHandler {
+ public:
+  PingHandler(MessagePipeHandle read_handle,
+              MessagePipeHandle write_handle,
+              const base::Closure& quit_closure)
+      : read_handle_(read_handle),
+        write_handle_(write_handle),
+        quit_closure_(quit_closure),
+        count_(0) {}
+
+  void Start() { Write(); }
+
+  void OnHandleReady(const Handle& handle) override {
+    CHECK_EQ(MOJO_RESULT_OK,
+             ReadMessageRaw(read_handle_, nullptr, nullptr, nullptr, nullptr,
+                            MOJO_READ_MESSAGE_FLAG_MAY_DISCARD));
+    if (++count_ == kMessages)
+      quit_closure_.Run();
+    else
+      Write();
+  }
+  void OnHandleError(const Handle& handle, MojoResult result) override {
+    NOTREACHED();
+  }
+
+ private:
+  void Write() {
+    CHECK_EQ(MOJO_RESULT_OK,
+             WriteMessageRaw(write_handle_, nullptr, 0, nullptr, 0,
+                             MOJO_WRITE_MESSAGE_FLAG_NONE));
+  }
+
+  MessagePipeHandle read_handle_;
+  MessagePipeHandle write_handle_;
+  base::Closure quit_closure_;
+  int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(PingHandler);
+};
+
+void Measure(int idle_pipes) {
+  base::MessageLoop message_loop(common::MessagePumpMojo::Create());
+  common::MessagePumpMojo* pump = common::MessagePumpMojo::current();
+
+  IdleHandler idle_handler;
+  ScopedVector<MessagePipe> pipes;
+  for (int i = 0; i < idle_pipes; ++i) {
+    pipes.push_back(new MessagePipe);
+    pump->AddHandler(&idle_handler, pipes.back()->handle0.get(),
+                     MOJO_HANDLE_SIGNAL_READABLE, base::TimeTicks());
+  }
+
+  MessagePipe ping_pipe;
+  base::RunLoop run_loop;
+  PingHandler ping_handler(ping_pipe.handle0.get(), ping_pipe.handle1.get(),
+                           run_loop.QuitClosure());
+  pump->AddHandler(&ping_handler, ping_pipe.handle0.get(),
+                   MOJO_HANDLE_SIGNAL_READABLE, base::TimeTicks());
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  ping_handler.Start();
+  run_loop.Run();
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  pump->RemoveHandler(ping_pipe.handle0.get());
+  for (MessagePipe* pipe : pipes)
+    pump->RemoveHandler(pipe->handle0.get());
+
+  LogPerfResult("MessagePumpMojoPerfTest",
+                base::StringPrintf("%d idle pipes", idle_pipes).c_str(),
+                static_cast<double>(elapsed.InMicroseconds()) / kMessages,
+                "us/message");
+}
+
+TEST(MessagePumpMojoPerfTest, IdlePipes1) {
+  Measure(1);
+}
+
+TEST(MessagePumpMojoPerfTest, IdlePipes10) {
+  Measure(10);
+}
+
+TEST(MessagePumpMojoPerfTest, IdlePipes100) {
+  Measure(100);
+}
+
+TEST(MessagePumpMojoPerfTest, IdlePipes1000) {
+  Measure(1000);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace mojo
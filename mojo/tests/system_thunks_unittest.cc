@@ -0,0 +1,90 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/platform/native/system_thunks.h"
+
+#include <string.h>
+
+#include "mojo/public/c/system/functions.h"
+#include "mojo/public/c/system/wait_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+extern "C" size_t MojoSetSystemThunks(const MojoSystemThunks* system_thunks);
+
+namespace mojo {
+namespace {
+
+const MojoTimeTicks kFakeTimeTicks = 1234;
+const MojoHandle kFakeWaitSetHandle = 42;
+
+MojoTimeTicks FakeGetTimeTicksNow() {
+  return kFakeTimeTicks;
+}
+
+MojoResult FakeCreateWaitSet(MojoHandle* wait_set_handle) {
+  *wait_set_handle = kFakeWaitSetHandle;
+  return MOJO_RESULT_OK;
+}
+
+// Returns a table holding only the fakes above, sized to |size| bytes.
+MojoSystemThunks MakeFakeThunks(size_t size) {
+  MojoSystemThunks thunks;
+  memset(&thunks, 0, sizeof(thunks));
+  thunks.size = size;
+  thunks.GetTimeTicksNow = FakeGetTimeTicksNow;
+  thunks.CreateWaitSet = FakeCreateWaitSet;
+  return thunks;
+}
+
+TEST(SystemThunksTest, MinimumSizeTable) {
+  MojoSystemThunks thunks = MakeFakeThunks(MOJO_SYSTEM_THUNKS_MINIMUM_SIZE);
+  EXPECT_EQ(sizeof(MojoSystemThunks), MojoSetSystemThunks(&thunks));
+
+  EXPECT_EQ(kFakeTimeTicks, MojoGetTimeTicksNow());
+
+  // The wait set functions lie past the end of the table, so they must not be
+  // read from it even though the fake table has them set.
+  MojoHandle wait_set = MOJO_HANDLE_INVALID;
+  EXPECT_EQ(MOJO_RESULT_UNIMPLEMENTED, MojoCreateWaitSet(&wait_set));
+  EXPECT_EQ(MOJO_HANDLE_INVALID, wait_set);
+  EXPECT_EQ(MOJO_RESULT_UNIMPLEMENTED,
+            MojoWaitSetAdd(kFakeWaitSetHandle, kFakeWaitSetHandle,
+                           MOJO_HANDLE_SIGNAL_READABLE, 0));
+  EXPECT_EQ(MOJO_RESULT_UNIMPLEMENTED,
+            MojoWaitSetRemove(kFakeWaitSetHandle, 0));
+  uint32_t num_results = 1;
+  MojoWaitSetResult result;
+  EXPECT_EQ(MOJO_RESULT_UNIMPLEMENTED,
+            MojoWaitSetWait(kFakeWaitSetHandle, MOJO_DEADLINE_INDEFINITE,
+                            &num_results, &result));
+}
+
+TEST(SystemThunksTest, FullSizeTable) {
+  MojoSystemThunks thunks = MakeFakeThunks(sizeof(MojoSystemThunks));
+  EXPECT_EQ(sizeof(MojoSystemThunks), MojoSetSystemThunks(&thunks));
+
+  MojoHandle wait_set = MOJO_HANDLE_INVALID;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoCreateWaitSet(&wait_set));
+  EXPECT_EQ(kFakeWaitSetHandle, wait_set);
+  // Functions the embedder left null are still reported as unimplemented.
+  EXPECT_EQ(MOJO_RESULT_UNIMPLEMENTED,
+            MojoWaitSetRemove(kFakeWaitSetHandle, 0));
+}
+
+TEST(SystemThunksTest, TooSmallTableIsIgnored) {
+  MojoSystemThunks thunks = MakeFakeThunks(sizeof(MojoSystemThunks));
+  MojoSetSystemThunks(&thunks);
+
+  MojoSystemThunks too_small = MakeFakeThunks(sizeof(too_small.size));
+  too_small.GetTimeTicksNow = nullptr;
+  EXPECT_EQ(sizeof(MojoSystemThunks), MojoSetSystemThunks(&too_small));
+
+  // The previously installed table is still in use.
+  EXPECT_EQ(kFakeTimeTicks, MojoGetTimeTicksNow());
+  MojoHandle wait_set = MOJO_HANDLE_INVALID;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoCreateWaitSet(&wait_set));
+}
+
+}  // namespace
+}  // namespace mojo
@@ -4,20 +4,32 @@
 
 #include "services/sky/compositor/texture_cache.h"
 
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/single_thread_task_runner.h"
+#include "base/thread_task_runner_handle.h"
 #include "mojo/converters/geometry/geometry_type_converters.h"
 #include "mojo/gpu/gl_texture.h"
+#include "sky/engine/public/web/Sky.h"
 
 namespace sky {
 
-TextureCache::TextureCache() {
+TextureCache::TextureCache()
+    : task_runner_(base::ThreadTaskRunnerHandle::Get()),
+      memory_usage_in_bytes_(0),
+      weak_factory_(this) {
+  weak_this_ = weak_factory_.GetWeakPtr();
+  blink::registerPurgeableCache(this);
 }
 
 TextureCache::~TextureCache() {
+  blink::unregisterPurgeableCache(this);
 }
 
 scoped_ptr<mojo::GLTexture> TextureCache::GetTexture(const gfx::Size& size) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
   if (size != size_) {
-    available_textures_.clear();
+    Clear();
     size_ = size;
   }
   if (available_textures_.empty())
@@ -25,13 +37,46 @@ scoped_ptr<mojo::GLTexture> TextureCache::GetTexture(const gfx::Size& size) {
   scoped_ptr<mojo::GLTexture> texture(available_textures_.back());
   available_textures_.back() = nullptr;
   available_textures_.pop_back();
+  UpdateMemoryUsage();
   return texture.Pass();
 }
 
 void TextureCache::PutTexture(scoped_ptr<mojo::GLTexture> texture) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
   if (texture->size() != size_)
     return;
   available_textures_.push_back(texture.release());
+  UpdateMemoryUsage();
+}
+
+const char* TextureCache::cacheName() const {
+  return "TextureCache";
+}
+
+size_t TextureCache::memoryUsageInBytes() {
+  return base::subtle::Acquire_Load(&memory_usage_in_bytes_);
+}
+
+void TextureCache::purge(blink::WebMemoryPressureLevel level) {
+  // Every texture in the cache is idle, so there is nothing to keep.
+  if (task_runner_->BelongsToCurrentThread()) {
+    Clear();
+    return;
+  }
+  task_runner_->PostTask(FROM_HERE,
+                         base::Bind(&TextureCache::Clear, weak_this_));
+}
+
+void TextureCache::Clear() {
+  // Each texture makes its own context current before deleting itself.
+  available_textures_.clear();
+  UpdateMemoryUsage();
+}
+
+void TextureCache::UpdateMemoryUsage() {
+  // Textures are allocated as RGBA.
+  base::subtle::Release_Store(&memory_usage_in_bytes_,
+                              available_textures_.size() * size_.GetArea() * 4);
 }
 
 }  // namespace sky
@@ -5,27 +5,56 @@
 #ifndef SKY_VIEWER_COMPOSITOR_TEXTURE_CACHE_H_
 #define SKY_VIEWER_COMPOSITOR_TEXTURE_CACHE_H_
 
+#include "base/atomicops.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
+#include "base/memory/weak_ptr.h"
+#include "sky/engine/public/platform/WebPurgeableCache.h"
 #include "ui/gfx/geometry/size.h"
 
+namespace base {
+class SingleThreadTaskRunner;
+}
+
 namespace mojo {
 class GLTexture;
 }
 
 namespace sky {
 
-class TextureCache {
+// Keeps idle textures of the current size for reuse. The cache is used on the
+// thread of the GL context its textures belong to, but memory pressure is
+// signalled on the engine's main thread, so purge() posts back to that
+// thread, where deleting a texture can make its context current.
+class TextureCache : public blink::WebPurgeableCache {
  public:
   TextureCache();
-  ~TextureCache();
+  ~TextureCache() override;
 
   scoped_ptr<mojo::GLTexture> GetTexture(const gfx::Size& size);
   void PutTexture(scoped_ptr<mojo::GLTexture> texture);
 
+  // blink::WebPurgeableCache implementation. These may be called on any
+  // thread.
+  const char* cacheName() const override;
+  size_t memoryUsageInBytes() override;
+  void purge(blink::WebMemoryPressureLevel level) override;
+
  private:
+  void Clear();
+  void UpdateMemoryUsage();
+
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   gfx::Size size_;
   ScopedVector<mojo::GLTexture> available_textures_;
+  // The size of |available_textures_|, readable from other threads.
+  base::subtle::AtomicWord memory_usage_in_bytes_;
+
+  // Made on the cache's thread, so that purge() can post with it from any
+  // thread.
+  base::WeakPtr<TextureCache> weak_this_;
+  base::WeakPtrFactory<TextureCache> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(TextureCache);
 };
@@ -313,4 +313,20 @@ void DocumentView::ScheduleFrame() {
   layer_host_->SetNeedsAnimate();
 }
 
+void DocumentView::ScheduleIdleTasks() {
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::Bind(&DocumentView::RunIdleTasks, GetWeakPtr()));
+}
+
+void DocumentView::RunIdleTasks() {
+  if (!sky_view_)
+    return;
+  // The layer host doesn't tell us when the next frame is due, so give the
+  // tasks one frame's worth of time.
+  sky_view_->RunIdleTasks(base::TimeTicks::Now() +
+                          base::TimeDelta::FromMilliseconds(16));
+  if (sky_view_->HasIdleTasks())
+    ScheduleIdleTasks();
+}
+
 }  // namespace sky
@@ -65,6 +65,7 @@ class DocumentView : public blink::ServiceProvider,
 
   // SkyViewClient methods:
   void ScheduleFrame() override;
+  void ScheduleIdleTasks() override;
 
   void StartDebuggerInspectorBackend();
 
@@ -75,6 +76,8 @@ class DocumentView : public blink::ServiceProvider,
   mojo::ScopedMessagePipeHandle TakeServiceRegistry();
 
  private:
+  void RunIdleTasks();
+
   // SkyViewClient methods:
   void DidCreateIsolate(Dart_Isolate isolate) override;
 
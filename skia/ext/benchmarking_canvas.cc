@@ -678,6 +678,12 @@ void BenchmarkingCanvas::onDrawPicture(const SkPicture* picture,
                                        const SkMatrix* matrix,
                                        const SkPaint* paint) {
   DCHECK(picture);
+  if (flags_ & kExpandPictures_Flag) {
+    // SkCanvas' implementation plays the picture back through this canvas.
+    SkCanvas::onDrawPicture(picture, matrix, paint);
+    return;
+  }
+
   AutoOp op(this, "DrawPicture", paint);
   op.addParam("picture", AsValue(picture));
   if (matrix)
@@ -20,6 +20,9 @@ public:
 
   enum Flags {
       kOverdrawVisualization_Flag = 0x01,
+      // Plays nested pictures back through this canvas, so that their ops are
+      // recorded one by one instead of as a single DrawPicture.
+      kExpandPictures_Flag = 0x02,
   };
 
   // Returns the number of draw commands executed on this canvas.
@@ -0,0 +1,46 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures creating short-lived Dart wrappers for objects returned by the
+// engine. Each iteration alternates between node and ClientRect wrappers,
+// which is the pattern DartClassLibrary's recent class table is meant for.
+
+import "dart:sky";
+
+const int kNodes = 100;
+const int kIterations = 1000;
+
+void main() {
+  LayoutRoot layoutRoot = new LayoutRoot();
+  layoutRoot.maxWidth = 800.0;
+  layoutRoot.maxHeight = 600.0;
+
+  Document document = new Document();
+  Element container = document.createElement('container');
+  List<Element> items = new List<Element>();
+  for (int i = 0; i < kNodes; ++i) {
+    Element item = document.createElement('item');
+    item.style['height'] = '1px';
+    items.add(item);
+    container.appendChild(item);
+  }
+  layoutRoot.rootElement = container;
+  layoutRoot.layout();
+
+  int wrappers = 0;
+  Stopwatch stopwatch = new Stopwatch()..start();
+  for (int i = 0; i < kIterations; ++i) {
+    for (Element item in items) {
+      // Every call returns a new ClientRect and a new Text node.
+      item.getBoundingClientRect();
+      document.createText('');
+      wrappers += 2;
+    }
+  }
+  stopwatch.stop();
+
+  double nsPerWrapper = stopwatch.elapsedMicroseconds * 1000.0 / wrappers;
+  print('wrapper_churn: $wrappers wrappers, '
+        '${nsPerWrapper.toStringAsFixed(1)} ns per wrapper');
+}
@@ -0,0 +1,51 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures relayout of nested column flexboxes when the root gets wider.
+// The outer levels stretch to the new width, but the fixed width boxes at
+// kFixedDepth keep theirs, so RenderFlexibleBox can reuse their measured
+// heights instead of laying them out again to measure them.
+
+import "dart:sky";
+
+const int kDepth = 6;
+const int kFixedDepth = 3;
+const int kFanOut = 3;
+const int kIterations = 20;
+
+Element build(Document document, int depth) {
+  Element box = document.createElement('box');
+  box.style['display'] = 'flex';
+  box.style['flex-direction'] = 'column';
+  if (depth == kFixedDepth)
+    box.style['width'] = '50px';
+  if (depth == 0) {
+    box.style['height'] = '2px';
+    return box;
+  }
+  for (int i = 0; i < kFanOut; ++i)
+    box.appendChild(build(document, depth - 1));
+  return box;
+}
+
+void main() {
+  LayoutRoot layoutRoot = new LayoutRoot();
+  layoutRoot.maxHeight = 100000.0;
+
+  Document document = new Document();
+  layoutRoot.rootElement = build(document, kDepth);
+  layoutRoot.maxWidth = 800.0;
+  layoutRoot.layout();
+
+  Stopwatch stopwatch = new Stopwatch()..start();
+  for (int i = 0; i < kIterations; ++i) {
+    layoutRoot.maxWidth = i.isEven ? 600.0 : 800.0;
+    layoutRoot.layout();
+  }
+  stopwatch.stop();
+
+  double msPerLayout = stopwatch.elapsedMicroseconds / 1000.0 / kIterations;
+  print('nested_column_resize: depth $kDepth, '
+        '${msPerLayout.toStringAsFixed(3)} ms per layout');
+}
@@ -0,0 +1,46 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures style recalc after changing an inherited property (color) on a
+// container with a 10k-node subtree. None of the descendants declare color,
+// so they can take the inherited-only path instead of being resolved again.
+
+import "dart:sky";
+
+const int kGroups = 100;
+const int kItemsPerGroup = 99;
+const int kIterations = 50;
+
+void main() {
+  LayoutRoot layoutRoot = new LayoutRoot();
+  layoutRoot.maxWidth = 800.0;
+  layoutRoot.maxHeight = 600.0;
+
+  Document document = new Document();
+  Element container = document.createElement('container');
+  for (int i = 0; i < kGroups; ++i) {
+    Element group = document.createElement('group');
+    group.style['padding'] = '1px';
+    for (int j = 0; j < kItemsPerGroup; ++j) {
+      Element item = document.createElement('item');
+      item.style['margin'] = '${j % 4}px';
+      group.appendChild(item);
+    }
+    container.appendChild(group);
+  }
+  layoutRoot.rootElement = container;
+  layoutRoot.layout();
+
+  Stopwatch stopwatch = new Stopwatch()..start();
+  for (int i = 0; i < kIterations; ++i) {
+    container.style['color'] = i.isEven ? 'red' : 'blue';
+    layoutRoot.layout();
+  }
+  stopwatch.stop();
+
+  int nodes = kGroups * (kItemsPerGroup + 1) + 1;
+  double msPerChange = stopwatch.elapsedMicroseconds / 1000.0 / kIterations;
+  print('inherited_color_change: $nodes nodes, '
+        '${msPerChange.toStringAsFixed(3)} ms per color change');
+}
@@ -86,6 +86,7 @@ class StyleBuilderWriter(css_properties.CSSProperties):
     def generate_style_builder(self):
         return {
             'properties': self._properties,
+            'properties_list': self._properties_list,
         }
 
 
@@ -1182,6 +1182,56 @@ PassRefPtr<CSSPrimitiveValue> CSSPrimitiveValue::cloneForCSSOM() const
     return result;
 }
 
+unsigned CSSPrimitiveValue::hash() const
+{
+    // Follows equals(): values of the types it compares by their contents
+    // hash those contents, and the rest hash their type alone.
+    unsigned hash = WTF::intHash(static_cast<unsigned>(m_primitiveUnitType));
+    switch (m_primitiveUnitType) {
+    case CSS_NUMBER:
+    case CSS_PERCENTAGE:
+    case CSS_EMS:
+    case CSS_EXS:
+    case CSS_PX:
+    case CSS_CM:
+    case CSS_DPPX:
+    case CSS_DPI:
+    case CSS_DPCM:
+    case CSS_MM:
+    case CSS_IN:
+    case CSS_PT:
+    case CSS_PC:
+    case CSS_DEG:
+    case CSS_RAD:
+    case CSS_GRAD:
+    case CSS_MS:
+    case CSS_S:
+    case CSS_HZ:
+    case CSS_KHZ:
+    case CSS_TURN:
+    case CSS_VW:
+    case CSS_VH:
+    case CSS_VMIN:
+    case CSS_VMAX:
+    case CSS_DIMENSION:
+    case CSS_FR:
+        return WTF::pairIntHash(hash, WTF::FloatHash<double>::hash(m_value.num));
+    case CSS_PROPERTY_ID:
+        return WTF::pairIntHash(hash, m_value.propertyID);
+    case CSS_VALUE_ID:
+        return WTF::pairIntHash(hash, m_value.valueID);
+    case CSS_STRING:
+    case CSS_URI:
+    case CSS_ATTR:
+    case CSS_PARSER_HEXCOLOR:
+        return WTF::pairIntHash(hash, m_value.string ? m_value.string->hash() : 0);
+    case CSS_RGBCOLOR:
+        return WTF::pairIntHash(hash, m_value.rgbcolor);
+    default:
+        return hash;
+    }
+}
+
 bool CSSPrimitiveValue::equals(const CSSPrimitiveValue& other) const
 {
     if (m_primitiveUnitType != other.m_primitiveUnitType)
@@ -97,6 +97,23 @@ inline static bool compareCSSValues(const CSSValue& first, const CSSValue& secon
     return static_cast<const ChildClassType&>(first).equals(static_cast<const ChildClassType&>(second));
 }
 
+unsigned CSSValue::hash() const
+{
+    if (m_isTextClone)
+        return cssText().impl() ? cssText().impl()->hash() : 0;
+
+    switch (m_classType) {
+    case PrimitiveClass:
+        return toCSSPrimitiveValue(this)->hash();
+    case ValueListClass:
+        return toCSSValueList(this)->hash();
+    default:
+        // The other classes are rare in parsed declarations; equals() tells
+        // their values apart.
+        return WTF::intHash(static_cast<unsigned>(m_classType));
+    }
+}
+
 bool CSSValue::equals(const CSSValue& other) const
 {
     if (m_isTextClone) {
@@ -103,6 +103,9 @@ public:
     PassRefPtr<CSSValue> cloneForCSSOM() const;
 
     bool equals(const CSSValue&) const;
+    // Equal values hash the same. Unlike hashing cssText(), this doesn't
+    // serialize the value.
+    unsigned hash() const;
 
 protected:
 
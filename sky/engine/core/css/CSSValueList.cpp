@@ -127,6 +127,18 @@ bool CSSValueList::equals(const CSSValue& other) const
     return value && value->equals(other);
 }
 
+unsigned CSSValueList::hash() const
+{
+    // A list of one value equals that value, so it hashes the same.
+    if (m_values.size() == 1)
+        return m_values[0] ? m_values[0]->hash() : 0;
+
+    unsigned hash = WTF::intHash(static_cast<unsigned>(m_values.size()));
+    for (size_t i = 0; i < m_values.size(); ++i)
+        hash = WTF::pairIntHash(hash, m_values[i] ? m_values[i]->hash() : 0);
+    return hash;
+}
+
 CSSValueList::CSSValueList(const CSSValueList& cloneFrom)
     : CSSValue(cloneFrom.classType(), /* isCSSOMSafe */ true)
 {
@@ -56,6 +56,7 @@ public:
     String customCSSText(CSSTextFormattingFlags = QuoteCSSStringIfNeeded) const;
     bool equals(const CSSValueList&) const;
     bool equals(const CSSValue&) const;
+    unsigned hash() const;
 
     PassRefPtr<CSSValueList> cloneForCSSOM() const;
 
@@ -38,15 +38,26 @@
 namespace blink {
 
 ElementRuleCollector::ElementRuleCollector(const ElementResolveContext& context,
-    RenderStyle* style)
+    RenderStyle* style, StyleResolver* styleResolver)
     : m_context(context)
     , m_style(style)
+    , m_styleResolver(styleResolver)
 { }
 
 ElementRuleCollector::~ElementRuleCollector()
 {
 }
 
+StyleResolverStats* ElementRuleCollector::stats() const
+{
+    return m_styleResolver ? m_styleResolver->stats() : 0;
+}
+
+StyleResolverStats* ElementRuleCollector::statsTotals() const
+{
+    return m_styleResolver ? m_styleResolver->statsTotals() : 0;
+}
+
 MatchResult& ElementRuleCollector::matchedResult()
 {
     return m_result;
@@ -82,22 +93,31 @@ void ElementRuleCollector::collectMatchingRules(const MatchRequest& matchRequest
 
     Element& element = *m_context.element();
 
-    // We need to collect the rules for id, class, tag, and everything else into a buffer and
-    // then sort the buffer.
+    // We need to collect the rules for id, class, tag, attributes and everything else into a
+    // buffer and then sort the buffer.
     if (element.hasID())
-        collectMatchingRulesForList(matchRequest.ruleSet->idRules(element.idForStyleResolution()), cascadeOrder, matchRequest);
+        collectMatchingRulesForList(matchRequest.ruleSet->idRules(element.idForStyleResolution()), IdRuleBucket, cascadeOrder, matchRequest);
     if (element.isStyledElement() && element.hasClass()) {
         for (size_t i = 0; i < element.classNames().size(); ++i)
-            collectMatchingRulesForList(matchRequest.ruleSet->classRules(element.classNames()[i]), cascadeOrder, matchRequest);
+            collectMatchingRulesForList(matchRequest.ruleSet->classRules(element.classNames()[i]), ClassRuleBucket, cascadeOrder, matchRequest);
+    }
+
+    collectMatchingRulesForList(matchRequest.ruleSet->tagRules(element.localName()), TagRuleBucket, cascadeOrder, matchRequest);
+
+    // Each attribute rule is filed under one attribute it requires, and an
+    // element never has two attributes with the same name, so no rule is
+    // collected twice.
+    if (matchRequest.ruleSet->hasAttributeRules()) {
+        for (const Attribute& attribute : element.attributes())
+            collectMatchingRulesForList(matchRequest.ruleSet->attributeRules(attribute.localName()), AttributeRuleBucket, cascadeOrder, matchRequest);
     }
 
-    collectMatchingRulesForList(matchRequest.ruleSet->tagRules(element.localName()), cascadeOrder, matchRequest);
-    collectMatchingRulesForList(matchRequest.ruleSet->universalRules(), cascadeOrder, matchRequest);
+    collectMatchingRulesForList(matchRequest.ruleSet->universalRules(), UniversalRuleBucket, cascadeOrder, matchRequest);
 }
 
 void ElementRuleCollector::collectMatchingHostRules(const MatchRequest& matchRequest, CascadeOrder cascadeOrder)
 {
-    collectMatchingRulesForList(matchRequest.ruleSet->hostRules(), cascadeOrder, matchRequest);
+    collectMatchingRulesForList(matchRequest.ruleSet->hostRules(), HostRuleBucket, cascadeOrder, matchRequest);
 }
 
 void ElementRuleCollector::sortAndTransferMatchedRules()
@@ -133,10 +153,12 @@ inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData)
     return matched;
 }
 
-void ElementRuleCollector::collectRuleIfMatches(const RuleData& ruleData, CascadeOrder cascadeOrder, const MatchRequest& matchRequest)
+void ElementRuleCollector::collectRuleIfMatches(const RuleData& ruleData, RuleBucket bucket, CascadeOrder cascadeOrder, const MatchRequest& matchRequest)
 {
+    INCREMENT_STYLE_STATS_COUNTER(*this, rulesTested[bucket]);
     StyleRule* rule = ruleData.rule();
     if (ruleMatches(ruleData)) {
+        INCREMENT_STYLE_STATS_COUNTER(*this, rulesMatched[bucket]);
         // If the rule has no properties to apply, then ignore it in the non-debug mode.
         const StylePropertySet& properties = rule->properties();
         if (properties.isEmpty())
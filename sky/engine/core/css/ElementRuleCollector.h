@@ -27,6 +27,7 @@
 #include "sky/engine/core/css/resolver/ElementResolveContext.h"
 #include "sky/engine/core/css/resolver/MatchRequest.h"
 #include "sky/engine/core/css/resolver/MatchResult.h"
+#include "sky/engine/core/css/resolver/StyleResolverStats.h"
 #include "sky/engine/wtf/RefPtr.h"
 #include "sky/engine/wtf/Vector.h"
 
@@ -34,6 +35,7 @@ namespace blink {
 
 class CSSStyleSheet;
 class ScopedStyleResolver;
+class StyleResolver;
 
 typedef unsigned CascadeOrder;
 
@@ -87,7 +89,7 @@ class ElementRuleCollector {
     STACK_ALLOCATED();
     WTF_MAKE_NONCOPYABLE(ElementRuleCollector);
 public:
-    ElementRuleCollector(const ElementResolveContext&, RenderStyle* = 0);
+    ElementRuleCollector(const ElementResolveContext&, RenderStyle* = 0, StyleResolver* = 0);
     ~ElementRuleCollector();
 
     MatchResult& matchedResult();
@@ -99,18 +101,22 @@ public:
     void addElementStyleProperties(const StylePropertySet*, bool isCacheable = true);
 
 private:
-    void collectRuleIfMatches(const RuleData&, CascadeOrder, const MatchRequest&);
+    void collectRuleIfMatches(const RuleData&, RuleBucket, CascadeOrder, const MatchRequest&);
 
     template<typename RuleDataListType>
-    void collectMatchingRulesForList(const RuleDataListType* rules, CascadeOrder cascadeOrder, const MatchRequest& matchRequest)
+    void collectMatchingRulesForList(const RuleDataListType* rules, RuleBucket bucket, CascadeOrder cascadeOrder, const MatchRequest& matchRequest)
     {
         if (!rules)
             return;
 
         for (typename RuleDataListType::const_iterator it = rules->begin(), end = rules->end(); it != end; ++it)
-            collectRuleIfMatches(*it, cascadeOrder, matchRequest);
+            collectRuleIfMatches(*it, bucket, cascadeOrder, matchRequest);
     }
 
+    // Stats are only collected when a resolver is given.
+    StyleResolverStats* stats() const;
+    StyleResolverStats* statsTotals() const;
+
     bool ruleMatches(const RuleData&);
 
     void sortMatchedRules();
@@ -119,6 +125,7 @@ private:
 private:
     const ElementResolveContext& m_context;
     RefPtr<RenderStyle> m_style; // FIXME: This can be mutated during matching!
+    StyleResolver* m_styleResolver;
 
     OwnPtr<Vector<MatchedRule, 32> > m_matchedRules;
 
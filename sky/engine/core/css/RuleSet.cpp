@@ -59,7 +59,7 @@ void RuleSet::addToRuleSet(const AtomicString& key, PendingRuleMap& map, const R
     rules->push(ruleData);
 }
 
-static void extractValuesforSelector(const CSSSelector* selector, AtomicString& id, AtomicString& className, AtomicString& customPseudoElementName, AtomicString& tagName)
+static void extractValuesforSelector(const CSSSelector* selector, AtomicString& id, AtomicString& className, AtomicString& customPseudoElementName, AtomicString& tagName, AtomicString& attributeName)
 {
     switch (selector->match()) {
     case CSSSelector::Id:
@@ -72,6 +72,13 @@ static void extractValuesforSelector(const CSSSelector* selector, AtomicString&
         if (selector->tagQName().localName() != starAtom)
             tagName = selector->tagQName().localName();
         break;
+    case CSSSelector::Exact:
+    case CSSSelector::Set:
+        // Prefer the first attribute in the selector so that the key is stable
+        // for rules listing several.
+        if (attributeName.isEmpty())
+            attributeName = selector->attribute().localName();
+        break;
     default:
         break;
     }
@@ -83,6 +90,7 @@ bool RuleSet::findBestRuleSetAndAdd(const CSSSelector& component, RuleData& rule
     AtomicString className;
     AtomicString customPseudoElementName;
     AtomicString tagName;
+    AtomicString attributeName;
 
 #ifndef NDEBUG
     m_allRules.append(ruleData);
@@ -100,7 +108,7 @@ bool RuleSet::findBestRuleSetAndAdd(const CSSSelector& component, RuleData& rule
         // ignore them.
         if (it->pseudoType() == CSSSelector::PseudoHost)
             return true;
-        extractValuesforSelector(it, id, className, customPseudoElementName, tagName);
+        extractValuesforSelector(it, id, className, customPseudoElementName, tagName, attributeName);
     }
 
     // Prefer rule sets in order of most likely to apply infrequently.
@@ -116,6 +124,10 @@ bool RuleSet::findBestRuleSetAndAdd(const CSSSelector& component, RuleData& rule
         addToRuleSet(tagName, ensurePendingRules()->tagRules, ruleData);
         return true;
     }
+    if (!attributeName.isEmpty()) {
+        addToRuleSet(attributeName, ensurePendingRules()->attributeRules, ruleData);
+        return true;
+    }
 
     return false;
 }
@@ -194,6 +206,7 @@ void RuleSet::compactRules()
     compactPendingRules(pendingRules->idRules, m_idRules);
     compactPendingRules(pendingRules->classRules, m_classRules);
     compactPendingRules(pendingRules->tagRules, m_tagRules);
+    compactPendingRules(pendingRules->attributeRules, m_attributeRules);
     m_universalRules.shrinkToFit();
     m_fontFaceRules.shrinkToFit();
 }
@@ -79,6 +79,8 @@ public:
     const TerminatedArray<RuleData>* idRules(const AtomicString& key) const { ASSERT(!m_pendingRules); return m_idRules.get(key); }
     const TerminatedArray<RuleData>* classRules(const AtomicString& key) const { ASSERT(!m_pendingRules); return m_classRules.get(key); }
     const TerminatedArray<RuleData>* tagRules(const AtomicString& key) const { ASSERT(!m_pendingRules); return m_tagRules.get(key); }
+    const TerminatedArray<RuleData>* attributeRules(const AtomicString& key) const { ASSERT(!m_pendingRules); return m_attributeRules.get(key); }
+    bool hasAttributeRules() const { ASSERT(!m_pendingRules); return !m_attributeRules.isEmpty(); }
     const Vector<RuleData>* universalRules() const { ASSERT(!m_pendingRules); return &m_universalRules; }
     const Vector<RuleData>* hostRules() const { ASSERT(!m_pendingRules); return &m_hostRules; }
     const Vector<RawPtr<StyleRuleFontFace> >& fontFaceRules() const { return m_fontFaceRules; }
@@ -119,6 +121,7 @@ private:
         PendingRuleMap idRules;
         PendingRuleMap classRules;
         PendingRuleMap tagRules;
+        PendingRuleMap attributeRules;
 
     private:
         PendingRuleMaps() { }
@@ -134,6 +137,9 @@ private:
     CompactRuleMap m_idRules;
     CompactRuleMap m_classRules;
     CompactRuleMap m_tagRules;
+    // Rules without an id, class or tag, keyed by the local name of one of the
+    // attributes they test. Only elements carrying that attribute can match.
+    CompactRuleMap m_attributeRules;
     Vector<RuleData> m_universalRules;
     Vector<RuleData> m_hostRules;
     Vector<RawPtr<StyleRuleFontFace> > m_fontFaceRules;
@@ -0,0 +1,59 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/RuleSet.h"
+
+#include <gtest/gtest.h>
+#include "sky/engine/core/css/StyleSheetContents.h"
+#include "sky/engine/core/css/resolver/MatchRequest.h"
+
+namespace blink {
+
+namespace {
+
+PassOwnPtr<RuleSet> createRuleSet(const char* cssText)
+{
+    RefPtr<StyleSheetContents> sheet = StyleSheetContents::create(0, CSSParserContext());
+    sheet->parseString(cssText);
+    OwnPtr<RuleSet> ruleSet = RuleSet::create();
+    ruleSet->addRulesFromSheet(sheet.get());
+    ruleSet->compactRulesIfNeeded();
+    return ruleSet.release();
+}
+
+} // namespace
+
+TEST(RuleSetTest, AttributeOnlyRulesAreKeyedByAttribute)
+{
+    OwnPtr<RuleSet> ruleSet = createRuleSet("[state] { color: red; } [kind=primary] { color: blue; }");
+    ASSERT_TRUE(ruleSet->attributeRules("state"));
+    EXPECT_EQ(1u, ruleSet->attributeRules("state")->size());
+    ASSERT_TRUE(ruleSet->attributeRules("kind"));
+    EXPECT_EQ(1u, ruleSet->attributeRules("kind")->size());
+    EXPECT_TRUE(ruleSet->universalRules()->isEmpty());
+}
+
+TEST(RuleSetTest, TagKeyIsPreferredOverAttribute)
+{
+    OwnPtr<RuleSet> ruleSet = createRuleSet("button[kind=primary] { color: blue; }");
+    EXPECT_TRUE(ruleSet->tagRules("button"));
+    EXPECT_FALSE(ruleSet->attributeRules("kind"));
+    EXPECT_FALSE(ruleSet->hasAttributeRules());
+}
+
+TEST(RuleSetTest, FirstAttributeIsTheKey)
+{
+    OwnPtr<RuleSet> ruleSet = createRuleSet("[kind=primary][state] { color: blue; }");
+    EXPECT_TRUE(ruleSet->attributeRules("kind"));
+    EXPECT_FALSE(ruleSet->attributeRules("state"));
+}
+
+TEST(RuleSetTest, PseudoClassOnlyRulesStayUniversal)
+{
+    OwnPtr<RuleSet> ruleSet = createRuleSet(":hover { color: red; }");
+    EXPECT_EQ(1u, ruleSet->universalRules()->size());
+    EXPECT_FALSE(ruleSet->hasAttributeRules());
+}
+
+} // namespace blink
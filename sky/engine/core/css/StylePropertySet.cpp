@@ -29,7 +29,10 @@
 #include "sky/engine/core/css/StylePropertySerializer.h"
 #include "sky/engine/core/css/StyleSheetContents.h"
 #include "sky/engine/core/css/parser/BisonCSSParser.h"
+#include "sky/engine/wtf/HashMap.h"
+#include "sky/engine/wtf/MainThread.h"
 #include "sky/engine/wtf/text/StringBuilder.h"
+#include "sky/engine/wtf/text/StringHash.h"
 
 #ifndef NDEBUG
 #include <stdio.h>
@@ -50,12 +53,78 @@ PassRefPtr<ImmutableStylePropertySet> ImmutableStylePropertySet::create(const CS
     return adoptRef(new (slot) ImmutableStylePropertySet(properties, count, cssParserMode));
 }
 
+// Interned sets, keyed by a hash of their declarations. The table doesn't keep
+// the sets alive; they remove themselves when they are destroyed.
+typedef HashMap<unsigned, Vector<ImmutableStylePropertySet*, 1>, AlreadyHashed> InternedStylePropertySetMap;
+
+static InternedStylePropertySetMap& internedStylePropertySets()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(InternedStylePropertySetMap, sets, ());
+    return sets;
+}
+
+static unsigned metadataBits(const StylePropertyMetadata& metadata)
+{
+    return metadata.m_propertyID
+        | metadata.m_isSetFromShorthand << 10
+        | metadata.m_indexInShorthandsVector << 11
+        | metadata.m_implicit << 13
+        | metadata.m_inherited << 14;
+}
+
+static unsigned declarationsHash(const CSSProperty* properties, unsigned count, CSSParserMode cssParserMode)
+{
+    unsigned hash = WTF::intHash(static_cast<unsigned>(cssParserMode));
+    for (unsigned i = 0; i < count; ++i) {
+        hash = WTF::pairIntHash(hash, metadataBits(properties[i].metadata()));
+        hash = WTF::pairIntHash(hash, properties[i].value()->hash());
+    }
+    // Zero is the empty value of the table.
+    return AlreadyHashed::avoidDeletedValue(hash ? hash : 1);
+}
+
+PassRefPtr<ImmutableStylePropertySet> ImmutableStylePropertySet::createInterned(const CSSProperty* properties, unsigned count, CSSParserMode cssParserMode)
+{
+    unsigned hash = declarationsHash(properties, count, cssParserMode);
+    Vector<ImmutableStylePropertySet*, 1>& sets = internedStylePropertySets().add(hash, Vector<ImmutableStylePropertySet*, 1>()).storedValue->value;
+    for (ImmutableStylePropertySet* set : sets) {
+        if (set->hasProperties(properties, count, cssParserMode))
+            return set;
+    }
+    RefPtr<ImmutableStylePropertySet> set = create(properties, count, cssParserMode);
+    set->m_internedHash = hash;
+    sets.append(set.get());
+    return set.release();
+}
+
+bool ImmutableStylePropertySet::hasProperties(const CSSProperty* properties, unsigned count, CSSParserMode cssParserMode) const
+{
+    if (count != m_arraySize || cssParserMode != this->cssParserMode())
+        return false;
+    for (unsigned i = 0; i < count; ++i) {
+        if (metadataBits(metadataArray()[i]) != metadataBits(properties[i].metadata()))
+            return false;
+        const CSSValue* value = valueArray()[i];
+        if (value != properties[i].value() && !value->equals(*properties[i].value()))
+            return false;
+    }
+    return true;
+}
+
 PassRefPtr<ImmutableStylePropertySet> StylePropertySet::immutableCopyIfNeeded() const
 {
     if (!isMutable())
         return toImmutableStylePropertySet(const_cast<StylePropertySet*>(this));
     const MutableStylePropertySet* mutableThis = toMutableStylePropertySet(this);
-    return ImmutableStylePropertySet::create(mutableThis->m_propertyVector.data(), mutableThis->m_propertyVector.size(), cssParserMode());
+    return ImmutableStylePropertySet::createInterned(mutableThis->m_propertyVector.data(), mutableThis->m_propertyVector.size(), cssParserMode());
+}
+
+StylePropertySet::PropertyGroup StylePropertySet::propertyGroup(CSSPropertyID propertyID, bool isInherited)
+{
+    if (propertyID <= CSSPropertyLineHeight)
+        return isInherited ? HighPriorityInheritedGroup : HighPriorityNonInheritedGroup;
+    return isInherited ? LowPriorityInheritedGroup : LowPriorityNonInheritedGroup;
 }
 
 MutableStylePropertySet::MutableStylePropertySet(CSSParserMode cssParserMode)
@@ -73,12 +142,14 @@ MutableStylePropertySet::MutableStylePropertySet(const CSSProperty* properties,
 
 ImmutableStylePropertySet::ImmutableStylePropertySet(const CSSProperty* properties, unsigned length, CSSParserMode cssParserMode)
     : StylePropertySet(cssParserMode, length)
+    , m_internedHash(0)
 {
     StylePropertyMetadata* metadataArray = const_cast<StylePropertyMetadata*>(this->metadataArray());
     RawPtr<CSSValue>* valueArray = const_cast<RawPtr<CSSValue>*>(this->valueArray());
     for (unsigned i = 0; i < m_arraySize; ++i) {
         metadataArray[i] = properties[i].metadata();
         valueArray[i] = properties[i].value();
+        m_propertyGroups |= propertyGroup(properties[i].id(), properties[i].metadata().m_inherited);
 #if !ENABLE(OILPAN)
         valueArray[i]->ref();
 #endif
@@ -87,6 +158,17 @@ ImmutableStylePropertySet::ImmutableStylePropertySet(const CSSProperty* properti
 
 ImmutableStylePropertySet::~ImmutableStylePropertySet()
 {
+    if (m_internedHash) {
+        InternedStylePropertySetMap& map = internedStylePropertySets();
+        InternedStylePropertySetMap::iterator it = map.find(m_internedHash);
+        if (it != map.end()) {
+            size_t index = it->value.find(this);
+            if (index != kNotFound)
+                it->value.remove(index);
+            if (it->value.isEmpty())
+                map.remove(it);
+        }
+    }
 #if !ENABLE(OILPAN)
     RawPtr<CSSValue>* valueArray = const_cast<RawPtr<CSSValue>*>(this->valueArray());
     for (unsigned i = 0; i < m_arraySize; ++i)
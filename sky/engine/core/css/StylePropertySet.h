@@ -106,6 +106,23 @@ public:
 
     bool isMutable() const { return m_isMutable; }
 
+    // StyleResolver applies high priority properties, which the others depend
+    // on, in a pass before the low priority ones, and inherited properties on
+    // their own when only inherited values changed.
+    enum PropertyGroup {
+        HighPriorityInheritedGroup = 1 << 0,
+        HighPriorityNonInheritedGroup = 1 << 1,
+        LowPriorityInheritedGroup = 1 << 2,
+        LowPriorityNonInheritedGroup = 1 << 3,
+        AllPropertyGroups = (1 << 4) - 1,
+    };
+    static PropertyGroup propertyGroup(CSSPropertyID, bool isInherited);
+
+    // The groups this set has properties in, so that a resolver pass can skip
+    // sets it has nothing to apply from. Mutable sets don't keep track and
+    // report all groups.
+    unsigned propertyGroups() const { return m_isMutable ? unsigned(AllPropertyGroups) : m_propertyGroups; }
+
     static unsigned averageSizeInBytes();
 
 #ifndef NDEBUG
@@ -116,23 +133,26 @@ public:
 
 protected:
 
-    enum { MaxArraySize = (1 << 28) - 1 };
+    enum { MaxArraySize = (1 << 24) - 1 };
 
     StylePropertySet(CSSParserMode cssParserMode)
         : m_cssParserMode(cssParserMode)
         , m_isMutable(true)
         , m_arraySize(0)
+        , m_propertyGroups(AllPropertyGroups)
     { }
 
     StylePropertySet(CSSParserMode cssParserMode, unsigned immutableArraySize)
         : m_cssParserMode(cssParserMode)
         , m_isMutable(false)
         , m_arraySize(std::min(immutableArraySize, unsigned(MaxArraySize)))
+        , m_propertyGroups(0)
     { }
 
     unsigned m_cssParserMode : 3;
     mutable unsigned m_isMutable : 1;
-    unsigned m_arraySize : 28;
+    unsigned m_arraySize : 24;
+    unsigned m_propertyGroups : 4; // Only set for immutable sets.
 
     friend class PropertySetCSSStyleDeclaration;
 };
@@ -141,6 +161,12 @@ class ImmutableStylePropertySet : public StylePropertySet {
 public:
     ~ImmutableStylePropertySet();
     static PassRefPtr<ImmutableStylePropertySet> create(const CSSProperty* properties, unsigned count, CSSParserMode);
+    // Returns the set already interned with the same declarations, or interns
+    // a new one. Identical declaration blocks in different rules, sheets and
+    // style attributes then share one set, which also lets them share entries
+    // in the MatchedPropertiesCache. Sets are never mutated once created;
+    // changing one through the CSSOM makes a mutable copy.
+    static PassRefPtr<ImmutableStylePropertySet> createInterned(const CSSProperty* properties, unsigned count, CSSParserMode);
 
     unsigned propertyCount() const { return m_arraySize; }
 
@@ -153,10 +179,17 @@ public:
         return location;
     }
 
+private:
+    // The key of this set in the interned table, or zero if it isn't interned.
+    unsigned m_internedHash;
+
+public:
     void* m_storage;
 
 private:
     ImmutableStylePropertySet(const CSSProperty*, unsigned count, CSSParserMode);
+
+    bool hasProperties(const CSSProperty*, unsigned count, CSSParserMode) const;
 };
 
 inline const RawPtr<CSSValue>* ImmutableStylePropertySet::valueArray() const
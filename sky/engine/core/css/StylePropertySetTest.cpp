@@ -0,0 +1,102 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/StylePropertySet.h"
+
+#include <gtest/gtest.h>
+#include "sky/engine/core/css/CSSPrimitiveValue.h"
+#include "sky/engine/core/css/CSSValueList.h"
+#include "sky/engine/core/css/StyleRule.h"
+#include "sky/engine/core/css/StyleSheetContents.h"
+
+namespace blink {
+
+namespace {
+
+PassRefPtr<StyleSheetContents> createSheet(const char* cssText)
+{
+    RefPtr<StyleSheetContents> sheet = StyleSheetContents::create(0, CSSParserContext());
+    sheet->parseString(cssText);
+    return sheet.release();
+}
+
+const StylePropertySet& propertiesOfRule(StyleSheetContents* sheet, unsigned index)
+{
+    return toStyleRule(sheet->childRules()[index].get())->properties();
+}
+
+} // namespace
+
+TEST(StylePropertySetTest, IdenticalDeclarationsAreShared)
+{
+    RefPtr<StyleSheetContents> first = createSheet("a { color: red; margin: 1px; } b { color: red; margin: 1px; } c { color: blue; margin: 1px; }");
+    RefPtr<StyleSheetContents> second = createSheet("d { color: red; margin: 1px; }");
+
+    const StylePropertySet& properties = propertiesOfRule(first.get(), 0);
+    EXPECT_FALSE(properties.isMutable());
+    EXPECT_EQ(&properties, &propertiesOfRule(first.get(), 1));
+    EXPECT_EQ(&properties, &propertiesOfRule(second.get(), 0));
+    EXPECT_NE(&properties, &propertiesOfRule(first.get(), 2));
+}
+
+TEST(StylePropertySetTest, EqualValuesHashTheSame)
+{
+    RefPtr<CSSPrimitiveValue> length = CSSPrimitiveValue::create(10, CSSPrimitiveValue::CSS_PX);
+    EXPECT_EQ(length->hash(), CSSPrimitiveValue::create(10, CSSPrimitiveValue::CSS_PX)->hash());
+    EXPECT_NE(length->hash(), CSSPrimitiveValue::create(10, CSSPrimitiveValue::CSS_EMS)->hash());
+    EXPECT_EQ(CSSPrimitiveValue::create("x", CSSPrimitiveValue::CSS_STRING)->hash(), CSSPrimitiveValue::create("x", CSSPrimitiveValue::CSS_STRING)->hash());
+
+    // A list of one value equals that value.
+    RefPtr<CSSValueList> single = CSSValueList::createSpaceSeparated();
+    single->append(CSSPrimitiveValue::create(10, CSSPrimitiveValue::CSS_PX));
+    ASSERT_TRUE(single->equals(*length));
+    EXPECT_EQ(length->hash(), single->hash());
+
+    RefPtr<CSSValueList> first = CSSValueList::createCommaSeparated();
+    RefPtr<CSSValueList> second = CSSValueList::createCommaSeparated();
+    for (CSSValueList* list : { first.get(), second.get() }) {
+        list->append(CSSPrimitiveValue::createIdentifier(CSSValueSerif));
+        list->append(CSSPrimitiveValue::create("Roboto", CSSPrimitiveValue::CSS_STRING));
+    }
+    ASSERT_TRUE(first->equals(*second));
+    EXPECT_EQ(first->hash(), second->hash());
+}
+
+TEST(StylePropertySetTest, DeclarationsWithListsAreShared)
+{
+    RefPtr<StyleSheetContents> sheet = createSheet("a { font-family: 'Roboto', serif; transform: translate(1px, 2px); } b { font-family: 'Roboto', serif; transform: translate(1px, 2px); }");
+    EXPECT_EQ(&propertiesOfRule(sheet.get(), 0), &propertiesOfRule(sheet.get(), 1));
+}
+
+TEST(StylePropertySetTest, InternedSetsAreCopiedOnWrite)
+{
+    RefPtr<StyleSheetContents> sheet = createSheet("a { color: red; } b { color: red; }");
+    const StylePropertySet& shared = propertiesOfRule(sheet.get(), 0);
+
+    RefPtr<MutableStylePropertySet> copy = shared.mutableCopy();
+    copy->setProperty(CSSPropertyColor, "blue");
+    EXPECT_EQ("blue", copy->getPropertyValue(CSSPropertyColor));
+    EXPECT_EQ("red", shared.getPropertyValue(CSSPropertyColor));
+    EXPECT_EQ("red", propertiesOfRule(sheet.get(), 1).getPropertyValue(CSSPropertyColor));
+
+    // Interning the copy finds the set of the same declarations, if any.
+    RefPtr<ImmutableStylePropertySet> blue = copy->immutableCopyIfNeeded();
+    RefPtr<StyleSheetContents> blueSheet = createSheet("c { color: blue; }");
+    EXPECT_EQ(blue.get(), &propertiesOfRule(blueSheet.get(), 0));
+}
+
+TEST(StylePropertySetTest, DestroyedSetsLeaveTheTable)
+{
+    RefPtr<StyleSheetContents> sheet = createSheet("a { color: green; } b { color: green; padding: 2px; }");
+    RefPtr<ImmutableStylePropertySet> padded = propertiesOfRule(sheet.get(), 1).immutableCopyIfNeeded();
+    sheet.clear();
+
+    // The green set is gone, so the same declarations intern a new set, while
+    // the padded set is still shared.
+    RefPtr<StyleSheetContents> again = createSheet("c { color: green; } d { color: green; padding: 2px; }");
+    EXPECT_EQ("green", propertiesOfRule(again.get(), 0).getPropertyValue(CSSPropertyColor));
+    EXPECT_EQ(padded.get(), &propertiesOfRule(again.get(), 1));
+}
+
+} // namespace blink
@@ -917,7 +917,7 @@ PassRefPtr<ImmutableStylePropertySet> BisonCSSParser::createStylePropertySet()
     if (unusedEntries)
         results.remove(0, unusedEntries);
 
-    return ImmutableStylePropertySet::create(results.data(), results.size(), HTMLStandardMode);
+    return ImmutableStylePropertySet::createInterned(results.data(), results.size(), HTMLStandardMode);
 }
 
 void BisonCSSParser::rollbackLastProperties(int num)
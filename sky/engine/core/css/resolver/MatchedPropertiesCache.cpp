@@ -28,9 +28,13 @@
 
 #include "sky/engine/core/css/resolver/MatchedPropertiesCache.h"
 
+#include "base/bind.h"
 #include "sky/engine/core/css/StylePropertySet.h"
 #include "sky/engine/core/css/resolver/StyleResolverState.h"
 #include "sky/engine/core/rendering/style/RenderStyle.h"
+#include "sky/engine/core/script/dom_dart_state.h"
+#include "sky/engine/platform/IdleTaskQueue.h"
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
 
 namespace blink {
 
@@ -53,8 +57,16 @@ void CachedMatchedProperties::clear()
 
 MatchedPropertiesCache::MatchedPropertiesCache()
     : m_additionsSinceLastSweep(0)
-    , m_sweepTimer(this, &MatchedPropertiesCache::sweep)
+    , m_idleSweepPending(false)
+    , m_sweepTimer(this, &MatchedPropertiesCache::sweepTimerFired)
+    , m_weakFactory(this)
 {
+    PurgeableCacheRegistry::instance().add(this);
+}
+
+MatchedPropertiesCache::~MatchedPropertiesCache()
+{
+    PurgeableCacheRegistry::instance().remove(this);
 }
 
 const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const StyleResolverState& styleResolverState, const MatchResult& matchResult)
@@ -84,6 +96,12 @@ void MatchedPropertiesCache::add(const RenderStyle* style, const RenderStyle* pa
         && !m_sweepTimer.isActive()) {
         static const unsigned sweepTimeInSeconds = 60;
         m_sweepTimer.startOneShot(sweepTimeInSeconds, FROM_HERE);
+        // Outside of any SkyView's isolate, the timer alone does the sweep.
+        IdleTaskQueue* idleTaskQueue = DOMDartState::CurrentIdleTaskQueue();
+        if (idleTaskQueue && !m_idleSweepPending) {
+            m_idleSweepPending = true;
+            idleTaskQueue->postIdleTask(base::Bind(&MatchedPropertiesCache::sweepInIdleTime, m_weakFactory.GetWeakPtr()));
+        }
     }
 
     ASSERT(hash);
@@ -114,7 +132,19 @@ void MatchedPropertiesCache::clearViewportDependent()
     m_cache.removeAll(toRemove);
 }
 
-void MatchedPropertiesCache::sweep(Timer<MatchedPropertiesCache>*)
+void MatchedPropertiesCache::sweepTimerFired(Timer<MatchedPropertiesCache>*)
+{
+    sweep();
+}
+
+void MatchedPropertiesCache::sweepInIdleTime(base::TimeTicks)
+{
+    m_idleSweepPending = false;
+    if (m_sweepTimer.isActive())
+        sweep();
+}
+
+void MatchedPropertiesCache::sweep()
 {
     // FIXME(sky): Do we still need this now that we removed PresentationAttributeStyle?
     Vector<unsigned, 16> toRemove;
@@ -132,6 +162,29 @@ void MatchedPropertiesCache::sweep(Timer<MatchedPropertiesCache>*)
     }
     m_cache.removeAll(toRemove);
     m_additionsSinceLastSweep = 0;
+    m_sweepTimer.stop();
+}
+
+size_t MatchedPropertiesCache::memoryUsageInBytes()
+{
+    // The cached styles share most of their substructures with live styles, so
+    // only count what each entry owns outright.
+    size_t bytes = m_cache.capacity() * sizeof(Cache::ValueType);
+    for (Cache::iterator it = m_cache.begin(); it != m_cache.end(); ++it) {
+        const CachedMatchedProperties* cacheItem = it->value.get();
+        bytes += sizeof(CachedMatchedProperties) + 2 * sizeof(RenderStyle);
+        bytes += cacheItem->matchedProperties.capacity() * sizeof(RefPtr<StylePropertySet>);
+    }
+    return bytes;
+}
+
+void MatchedPropertiesCache::purge(WebMemoryPressureLevel level)
+{
+    if (level == WebMemoryPressureLevelCritical) {
+        clear();
+        return;
+    }
+    sweep();
 }
 
 bool MatchedPropertiesCache::isCacheable(const Element* element, const RenderStyle* style, const RenderStyle* parentStyle)
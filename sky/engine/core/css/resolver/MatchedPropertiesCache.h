@@ -25,8 +25,11 @@
 
 #include "sky/engine/core/css/StylePropertySet.h"
 #include "sky/engine/core/css/resolver/MatchResult.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "sky/engine/platform/Timer.h"
 #include "sky/engine/platform/heap/Handle.h"
+#include "sky/engine/public/platform/WebPurgeableCache.h"
 #include "sky/engine/wtf/Forward.h"
 #include "sky/engine/wtf/HashMap.h"
 #include "sky/engine/wtf/Noncopyable.h"
@@ -46,11 +49,12 @@ public:
     void clear();
 };
 
-class MatchedPropertiesCache {
+class MatchedPropertiesCache final : public WebPurgeableCache {
     DISALLOW_ALLOCATION();
     WTF_MAKE_NONCOPYABLE(MatchedPropertiesCache);
 public:
     MatchedPropertiesCache();
+    virtual ~MatchedPropertiesCache();
 
     const CachedMatchedProperties* find(unsigned hash, const StyleResolverState&, const MatchResult&);
     void add(const RenderStyle*, const RenderStyle* parentStyle, unsigned hash, const MatchResult&);
@@ -60,16 +64,27 @@ public:
 
     static bool isCacheable(const Element*, const RenderStyle*, const RenderStyle* parentStyle);
 
+    // WebPurgeableCache
+    virtual const char* cacheName() const override { return "MatchedPropertiesCache"; }
+    virtual size_t memoryUsageInBytes() override;
+    virtual void purge(WebMemoryPressureLevel) override;
+
 private:
     // Every N additions to the matched declaration cache trigger a sweep where entries holding
-    // the last reference to a style declaration are garbage collected.
-    void sweep(Timer<MatchedPropertiesCache>*);
+    // the last reference to a style declaration are garbage collected. The sweep runs in the
+    // next idle period, or when the timer fires if the engine doesn't go idle before then.
+    void sweepTimerFired(Timer<MatchedPropertiesCache>*);
+    void sweepInIdleTime(base::TimeTicks deadline);
+    void sweep();
 
     unsigned m_additionsSinceLastSweep;
+    bool m_idleSweepPending;
 
     typedef HashMap<unsigned, OwnPtr<CachedMatchedProperties> > Cache;
     Timer<MatchedPropertiesCache> m_sweepTimer;
     Cache m_cache;
+
+    base::WeakPtrFactory<MatchedPropertiesCache> m_weakFactory;
 };
 
 }
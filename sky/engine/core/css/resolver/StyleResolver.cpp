@@ -180,7 +180,7 @@ PassRefPtr<RenderStyle> StyleResolver::styleForElement(Element* element, RenderS
     state.fontBuilder().initForStyleResolve(state.document(), state.style());
 
     {
-        ElementRuleCollector collector(state.elementContext(), state.style());
+        ElementRuleCollector collector(state.elementContext(), state.style(), this);
 
         matchRules(*element, collector);
 
@@ -200,6 +200,37 @@ PassRefPtr<RenderStyle> StyleResolver::styleForElement(Element* element, RenderS
     return state.takeStyle();
 }
 
+PassRefPtr<RenderStyle> StyleResolver::styleForInheritedChange(const RenderStyle& oldStyle, const RenderStyle& parentStyle)
+{
+    // Any of these make the style depend on the parent's in ways other than
+    // plain inheritance.
+    if (oldStyle.declaresInheritedProperties()
+        || oldStyle.hasExplicitlyInheritedProperties()
+        || oldStyle.hasCurrentColor())
+        return nullptr;
+
+    // Font-relative lengths in non-inherited properties would need to be
+    // recomputed.
+    if (oldStyle.fontDescription() != parentStyle.fontDescription())
+        return nullptr;
+
+    // Direction-aware properties, like -webkit-margin-start, were mapped to
+    // physical sides using the old direction.
+    if (oldStyle.direction() != parentStyle.direction())
+        return nullptr;
+
+    // The StyleAdjuster combines the element's own text decorations with the
+    // inherited ones, or drops the inherited ones.
+    if (oldStyle.textDecoration() != TextDecorationNone || oldStyle.hasOutOfFlowPosition())
+        return nullptr;
+
+    INCREMENT_STYLE_STATS_COUNTER(*this, inheritedStylePropagated);
+
+    RefPtr<RenderStyle> style = RenderStyle::clone(&oldStyle);
+    style->inheritFrom(&parentStyle);
+    return style.release();
+}
+
 PassRefPtr<RenderStyle> StyleResolver::defaultStyleForElement()
 {
     StyleResolverState state(m_document, nullptr);
@@ -278,6 +309,13 @@ bool StyleResolver::isPropertyForPass(CSSPropertyID property)
 template <StyleResolver::StyleApplicationPass pass>
 void StyleResolver::applyProperties(StyleResolverState& state, const StylePropertySet* properties, bool inheritedOnly)
 {
+    COMPILE_ASSERT(CSSPropertyLineHeight + 1 == CSSPropertyAlignContent, property_groups_match_the_style_application_passes);
+    unsigned groups = pass == HighPriorityProperties ? StylePropertySet::HighPriorityInheritedGroup : StylePropertySet::LowPriorityInheritedGroup;
+    if (!inheritedOnly)
+        groups |= pass == HighPriorityProperties ? StylePropertySet::HighPriorityNonInheritedGroup : StylePropertySet::LowPriorityNonInheritedGroup;
+    if (!(properties->propertyGroups() & groups))
+        return;
+
     unsigned propertyCount = properties->propertyCount();
     for (unsigned i = 0; i < propertyCount; ++i) {
         StylePropertySet::PropertyReference current = properties->propertyAt(i);
@@ -293,6 +331,8 @@ void StyleResolver::applyProperties(StyleResolverState& state, const StyleProper
         CSSPropertyID property = current.id();
         if (!isPropertyForPass<pass>(property))
             continue;
+        if (current.isInherited())
+            state.style()->setDeclaresInheritedProperties();
         if (pass == HighPriorityProperties && property == CSSPropertyLineHeight)
             state.setLineHeightValue(current.value());
         else
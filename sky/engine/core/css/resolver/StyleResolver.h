@@ -65,6 +65,12 @@ public:
 
     PassRefPtr<RenderStyle> styleForElement(Element*, RenderStyle* parentStyle = 0);
 
+    // Returns a copy of |oldStyle| with its inherited properties taken from
+    // |parentStyle|, skipping rule matching, or null if the element must be
+    // resolved again with styleForElement(). Only valid when the element's
+    // own rules and inline style haven't changed since |oldStyle|.
+    PassRefPtr<RenderStyle> styleForInheritedChange(const RenderStyle& oldStyle, const RenderStyle& parentStyle);
+
     PassRefPtr<RenderStyle> defaultStyleForElement();
     PassRefPtr<RenderStyle> styleForText(Text*);
 
@@ -48,6 +48,11 @@ void StyleResolverStats::reset()
     matchedPropertyCacheHit = 0;
     matchedPropertyCacheInheritedHit = 0;
     matchedPropertyCacheAdded = 0;
+    inheritedStylePropagated = 0;
+    for (unsigned i = 0; i < RuleBucketCount; ++i) {
+        rulesTested[i] = 0;
+        rulesMatched[i] = 0;
+    }
 }
 
 String StyleResolverStats::report() const
@@ -76,6 +81,15 @@ String StyleResolverStats::report() const
     output.append(String::format("  %u cache hits also shared the inherited style (%.2f%%).\n", matchedPropertyCacheInheritedHit, PERCENT(matchedPropertyCacheInheritedHit, matchedPropertyCacheHit)));
     output.append(String::format("  %u styles created in applyMatchedProperties were added to the cache (%.2f%%).\n", matchedPropertyCacheAdded, PERCENT(matchedPropertyCacheAdded, matchedPropertyApply)));
 
+    output.append(String::format("  %u styles were updated by copying in their parent's inherited properties.\n", inheritedStylePropagated));
+
+    output.append('\n');
+
+    static const char* const bucketNames[RuleBucketCount] = { "id", "class", "tag", "attribute", "universal", "host" };
+    output.appendLiteral("Rule matching:\n");
+    for (unsigned i = 0; i < RuleBucketCount; ++i)
+        output.append(String::format("  %u %s rules tested, %u matched (%.2f%%).\n", rulesTested[i], bucketNames[i], rulesMatched[i], PERCENT(rulesMatched[i], rulesTested[i])));
+
     return output.toString();
 }
 
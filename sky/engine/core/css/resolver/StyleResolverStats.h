@@ -36,6 +36,17 @@
 
 namespace blink {
 
+// The RuleSet buckets ElementRuleCollector draws candidate rules from.
+enum RuleBucket {
+    IdRuleBucket,
+    ClassRuleBucket,
+    TagRuleBucket,
+    AttributeRuleBucket,
+    UniversalRuleBucket,
+    HostRuleBucket,
+    RuleBucketCount
+};
+
 class StyleResolverStats {
 public:
     static PassOwnPtr<StyleResolverStats> create()
@@ -55,6 +66,9 @@ public:
     unsigned matchedPropertyCacheHit;
     unsigned matchedPropertyCacheInheritedHit;
     unsigned matchedPropertyCacheAdded;
+    unsigned inheritedStylePropagated;
+    unsigned rulesTested[RuleBucketCount];
+    unsigned rulesMatched[RuleBucketCount];
 
     // We keep a separate flag for this since crawling the entire document to print
     // the number of missed candidates is very slow.
@@ -0,0 +1,145 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/resolver/StyleResolver.h"
+
+#include "core/testing/DummyPageHolder.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/rendering/style/RenderStyle.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+class StyleResolverTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_pageHolder = DummyPageHolder::create(IntSize(800, 600));
+        m_parent = document().createElement("div", nullAtom, ASSERT_NO_EXCEPTION);
+        m_child = document().createElement("div", nullAtom, ASSERT_NO_EXCEPTION);
+        m_parent->appendChild(m_child, ASSERT_NO_EXCEPTION);
+        document().appendChild(m_parent, ASSERT_NO_EXCEPTION);
+    }
+
+    Document& document() { return m_pageHolder->document(); }
+
+    void recalcStyle() { document().updateRenderTreeIfNeeded(); }
+
+    // Changes the parent's inline |property| to |value| and checks that the
+    // child's new style, which may have come from styleForInheritedChange(),
+    // matches resolving the child from scratch.
+    void expectChildMatchesFullResolve(CSSPropertyID property, const String& value)
+    {
+        recalcStyle();
+        m_parent->setInlineStyleProperty(property, value);
+        recalcStyle();
+
+        ASSERT_TRUE(m_child->renderStyle());
+        RefPtr<RenderStyle> resolved = document().styleResolver().styleForElement(m_child.get(), m_parent->renderStyle());
+        EXPECT_TRUE(*resolved == *m_child->renderStyle());
+    }
+
+    OwnPtr<DummyPageHolder> m_pageHolder;
+    RefPtr<Element> m_parent;
+    RefPtr<Element> m_child;
+};
+
+TEST_F(StyleResolverTest, InheritedChangeIsCopiedIntoChild)
+{
+    m_child->setInlineStyleProperty(CSSPropertyWidth, 10, CSSPrimitiveValue::CSS_PX);
+    m_parent->setInlineStyleProperty(CSSPropertyColor, "red");
+    recalcStyle();
+
+    m_parent->setInlineStyleProperty(CSSPropertyColor, "blue");
+    recalcStyle();
+
+    ASSERT_TRUE(m_child->renderStyle());
+    EXPECT_EQ(Color(0, 0, 255), m_child->renderStyle()->color());
+    EXPECT_EQ(Length(10, Fixed), m_child->renderStyle()->width());
+}
+
+TEST_F(StyleResolverTest, DirectionChangeRemapsDirectionAwareProperties)
+{
+    m_child->setInlineStyleProperty(CSSPropertyWebkitMarginStart, 10, CSSPrimitiveValue::CSS_PX);
+    m_parent->setInlineStyleProperty(CSSPropertyDirection, CSSValueLtr);
+    recalcStyle();
+
+    ASSERT_TRUE(m_child->renderStyle());
+    EXPECT_EQ(Length(10, Fixed), m_child->renderStyle()->marginLeft());
+    EXPECT_EQ(Length(0, Fixed), m_child->renderStyle()->marginRight());
+
+    m_parent->setInlineStyleProperty(CSSPropertyDirection, CSSValueRtl);
+    recalcStyle();
+
+    EXPECT_EQ(RTL, m_child->renderStyle()->direction());
+    EXPECT_EQ(Length(0, Fixed), m_child->renderStyle()->marginLeft());
+    EXPECT_EQ(Length(10, Fixed), m_child->renderStyle()->marginRight());
+}
+
+TEST_F(StyleResolverTest, InheritedChangeMatchesFullResolve)
+{
+    m_child->setInlineStyleProperty(CSSPropertyWidth, 10, CSSPrimitiveValue::CSS_PX);
+    m_parent->setInlineStyleProperty(CSSPropertyColor, "red");
+    expectChildMatchesFullResolve(CSSPropertyColor, "blue");
+}
+
+TEST_F(StyleResolverTest, FontSizeChangeMatchesFullResolveForEms)
+{
+    m_child->setInlineStyleProperty(CSSPropertyWidth, 2, CSSPrimitiveValue::CSS_EMS);
+    m_child->setInlineStyleProperty(CSSPropertyPaddingLeft, 1, CSSPrimitiveValue::CSS_EMS);
+    m_parent->setInlineStyleProperty(CSSPropertyFontSize, "10px");
+    expectChildMatchesFullResolve(CSSPropertyFontSize, "20px");
+    EXPECT_EQ(Length(40, Fixed), m_child->renderStyle()->width());
+}
+
+TEST_F(StyleResolverTest, ColorChangeMatchesFullResolveForCurrentColorBorders)
+{
+    m_child->setInlineStyleProperty(CSSPropertyBorderStyle, "solid");
+    m_child->setInlineStyleProperty(CSSPropertyBorderWidth, "1px");
+    m_child->setInlineStyleProperty(CSSPropertyBorderColor, "currentColor");
+    m_parent->setInlineStyleProperty(CSSPropertyColor, "red");
+    expectChildMatchesFullResolve(CSSPropertyColor, "blue");
+}
+
+TEST_F(StyleResolverTest, InheritedChangeMatchesFullResolveForExplicitInherit)
+{
+    // 'inherit' on a non-inherited property copies the parent's value, which
+    // plain inheritance would miss.
+    m_child->setInlineStyleProperty(CSSPropertyWidth, "inherit");
+    m_child->setInlineStyleProperty(CSSPropertyBackgroundColor, "inherit");
+    m_parent->setInlineStyleProperty(CSSPropertyWidth, "10px");
+    m_parent->setInlineStyleProperty(CSSPropertyBackgroundColor, "red");
+    m_parent->setInlineStyleProperty(CSSPropertyColor, "red");
+    recalcStyle();
+
+    m_parent->setInlineStyleProperty(CSSPropertyWidth, "20px");
+    m_parent->setInlineStyleProperty(CSSPropertyBackgroundColor, "green");
+    expectChildMatchesFullResolve(CSSPropertyColor, "blue");
+    EXPECT_EQ(Length(20, Fixed), m_child->renderStyle()->width());
+}
+
+TEST_F(StyleResolverTest, DirectionChangeMatchesFullResolve)
+{
+    m_child->setInlineStyleProperty(CSSPropertyWebkitMarginStart, 10, CSSPrimitiveValue::CSS_PX);
+    m_child->setInlineStyleProperty(CSSPropertyWebkitPaddingEnd, 5, CSSPrimitiveValue::CSS_PX);
+    m_parent->setInlineStyleProperty(CSSPropertyDirection, CSSValueLtr);
+    expectChildMatchesFullResolve(CSSPropertyDirection, "rtl");
+}
+
+TEST_F(StyleResolverTest, InheritedChangeMatchesFullResolveForPositionedElements)
+{
+    m_child->setInlineStyleProperty(CSSPropertyPosition, CSSValueAbsolute);
+    m_child->setInlineStyleProperty(CSSPropertyLeft, 1, CSSPrimitiveValue::CSS_EMS);
+    m_parent->setInlineStyleProperty(CSSPropertyTextDecoration, "underline");
+    m_parent->setInlineStyleProperty(CSSPropertyColor, "red");
+    expectChildMatchesFullResolve(CSSPropertyColor, "blue");
+}
+
+} // namespace
+
+} // namespace blink
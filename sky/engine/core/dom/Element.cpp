@@ -628,7 +628,18 @@ StyleRecalcChange Element::recalcOwnStyle(StyleRecalcChange change)
     ASSERT(parentRenderStyle());
 
     RefPtr<RenderStyle> oldStyle = renderStyle();
-    RefPtr<RenderStyle> newStyle = styleForRenderer();
+    RefPtr<RenderStyle> newStyle;
+
+    // Only our parent's inherited properties changed, so our matched rules
+    // are the same and the new style may just be the old one with the
+    // parent's inherited properties copied in.
+    if (oldStyle && change == Inherit && !needsStyleRecalc())
+        newStyle = document().styleResolver().styleForInheritedChange(*oldStyle, *parentRenderStyle());
+
+    if (newStyle)
+        document().didRecalculateStyleForElement();
+    else
+        newStyle = styleForRenderer();
     StyleRecalcChange localChange = RenderStyle::stylePropagationDiff(oldStyle.get(), newStyle.get());
 
     ASSERT(newStyle);
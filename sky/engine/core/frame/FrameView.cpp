@@ -35,6 +35,7 @@
 #include "sky/engine/core/loader/FrameLoaderClient.h"
 #include "sky/engine/core/page/ChromeClient.h"
 #include "sky/engine/core/page/Page.h"
+#include "sky/engine/core/rendering/RenderFlexibleBox.h"
 #include "sky/engine/core/rendering/RenderLayer.h"
 #include "sky/engine/core/rendering/RenderView.h"
 #include "sky/engine/core/rendering/style/RenderStyle.h"
@@ -219,7 +220,12 @@ void FrameView::performLayout(RenderObject* rootForThisLayout, bool inSubtreeLay
     // performLayout is the actual guts of layout().
     // FIXME: The 300 other lines in layout() probably belong in other helper functions
     // so that a single human could understand what layout() is actually doing.
+    RenderFlexibleBox::layoutStats() = RenderFlexibleBox::LayoutStats();
     rootForThisLayout->layout();
+    renderView()->invalidateHitTestIndex();
+
+    const RenderFlexibleBox::LayoutStats& flexStats = RenderFlexibleBox::layoutStats();
+    TRACE_COUNTER2("blink", "FlexMeasureCache", "hits", flexStats.measureCacheHits, "misses", flexStats.measureCacheMisses);
 }
 
 void FrameView::scheduleOrPerformPostLayoutTasks()
@@ -5,10 +5,41 @@
 #include "sky/engine/core/frame/Tracing.h"
 
 #include "base/trace_event/trace_event.h"
+#include "sky/engine/wtf/HashMap.h"
+#include "sky/engine/wtf/MainThread.h"
+#include "sky/engine/wtf/StdLibExtras.h"
+#include "sky/engine/wtf/Vector.h"
+#include "sky/engine/wtf/text/CString.h"
+#include "sky/engine/wtf/text/StringHash.h"
 #include "sky/engine/wtf/text/StringUTF8Adaptor.h"
 
 namespace blink {
 
+namespace {
+
+// The trace log keeps pointers to event and arg names, so registered names are
+// never freed. Ids index into the vector.
+struct RegisteredNames {
+    HashMap<String, unsigned> ids;
+    Vector<CString> names;
+};
+
+RegisteredNames& registeredNames()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(RegisteredNames, names, ());
+    return names;
+}
+
+// Scripts can pass any id, so unknown ones return null and are ignored.
+const char* registeredName(unsigned id)
+{
+    const Vector<CString>& names = registeredNames().names;
+    return id < names.size() ? names[id].data() : nullptr;
+}
+
+} // namespace
+
 Tracing::Tracing()
 {
 }
@@ -17,8 +48,54 @@ Tracing::~Tracing()
 {
 }
 
+bool Tracing::enabled() const
+{
+    bool enabled;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED("script", &enabled);
+    return enabled;
+}
+
+unsigned Tracing::registerName(const String& name)
+{
+    RegisteredNames& names = registeredNames();
+    HashMap<String, unsigned>::AddResult result = names.ids.add(name, names.names.size());
+    if (result.isNewEntry) {
+        StringUTF8Adaptor utf8(name);
+        names.names.append(CString(utf8.data(), utf8.length()));
+    }
+    return result.storedValue->value;
+}
+
+void Tracing::beginEvent(unsigned nameId)
+{
+    if (const char* name = registeredName(nameId))
+        TRACE_EVENT_BEGIN0("script", name);
+}
+
+void Tracing::beginEventWithArg(unsigned nameId, unsigned argNameId, long long value)
+{
+    const char* name = registeredName(nameId);
+    const char* argName = registeredName(argNameId);
+    if (name && argName)
+        TRACE_EVENT_BEGIN1("script", name, argName, value);
+}
+
+void Tracing::endEvent(unsigned nameId)
+{
+    if (const char* name = registeredName(nameId))
+        TRACE_EVENT_END0("script", name);
+}
+
+void Tracing::counter(unsigned nameId, int value)
+{
+    if (const char* name = registeredName(nameId))
+        TRACE_COUNTER1("script", name, value);
+}
+
 void Tracing::begin(const String& name)
 {
+    if (!enabled())
+        return;
     StringUTF8Adaptor utf8(name);
     // TRACE_EVENT_COPY_BEGIN0 needs a c-style null-terminated string.
     CString cstring(utf8.data(), utf8.length());
@@ -27,6 +104,8 @@ void Tracing::begin(const String& name)
 
 void Tracing::end(const String& name)
 {
+    if (!enabled())
+        return;
     StringUTF8Adaptor utf8(name);
     // TRACE_EVENT_COPY_END0 needs a c-style null-terminated string.
     CString cstring(utf8.data(), utf8.length());
@@ -12,12 +12,24 @@
 
 namespace blink {
 
+// Trace events in the "script" category. Scripts register the names of their
+// events once and then pass the ids, so that a disabled event costs a
+// category check and no string conversion.
 class Tracing : public RefCounted<Tracing>, public DartWrappable {
     DEFINE_WRAPPERTYPEINFO();
 public:
     ~Tracing() override;
     static PassRefPtr<Tracing> create() { return adoptRef(new Tracing); }
 
+    bool enabled() const;
+
+    unsigned registerName(const String& name);
+
+    void beginEvent(unsigned nameId);
+    void beginEventWithArg(unsigned nameId, unsigned argNameId, long long value);
+    void endEvent(unsigned nameId);
+    void counter(unsigned nameId, int value);
+
     void begin(const String& name);
     void end(const String& name);
 
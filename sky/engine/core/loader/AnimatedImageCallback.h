@@ -0,0 +1,20 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_LOADER_ANIMATEDIMAGECALLBACK_H_
+#define SKY_ENGINE_CORE_LOADER_ANIMATEDIMAGECALLBACK_H_
+
+namespace blink {
+
+class CanvasAnimatedImage;
+
+class AnimatedImageCallback {
+public:
+    virtual ~AnimatedImageCallback() {}
+    virtual void handleEvent(CanvasAnimatedImage* result) = 0;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_LOADER_ANIMATEDIMAGECALLBACK_H_
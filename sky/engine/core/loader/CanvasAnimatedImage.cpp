@@ -0,0 +1,278 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/loader/CanvasAnimatedImage.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/threading/worker_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "sky/engine/platform/graphics/ThreadSafeDataTransport.h"
+#include "sky/engine/platform/image-decoders/ImageDecoder.h"
+#include "sky/engine/wtf/ThreadSafeRefCounted.h"
+
+namespace blink {
+
+struct CanvasAnimatedImage::DecodeResult {
+  DecodeResult() : failed(false), repetition_count(cAnimationNone) {}
+
+  // The frames to decode.
+  std::vector<size_t> indices;
+
+  bool failed;
+  // Only set by the first decode, which reads the image's header.
+  int repetition_count;
+  std::vector<double> durations_ms;
+  // Parallel to |indices|. Null for frames that couldn't be decoded.
+  std::vector<SkBitmap> bitmaps;
+};
+
+// Owns the ImageDecoder, which decodes one batch of frames at a time on a
+// worker thread.
+class CanvasAnimatedImage::Decoder : public ThreadSafeRefCounted<Decoder> {
+ public:
+  static PassRefPtr<Decoder> create() { return adoptRef(new Decoder); }
+
+  void SetData(SharedBuffer* buffer) { transport_.setData(buffer, true); }
+
+  // Runs on a worker thread.
+  static void Run(const RefPtr<Decoder>& decoder, DecodeResult* result) {
+    decoder->Decode(result);
+  }
+
+ private:
+  Decoder() {}
+
+  bool Initialize(DecodeResult* result);
+  void Decode(DecodeResult* result);
+
+  ThreadSafeDataTransport transport_;
+  OwnPtr<ImageDecoder> decoder_;
+};
+
+bool CanvasAnimatedImage::Decoder::Initialize(DecodeResult* result) {
+  SharedBuffer* data = nullptr;
+  bool all_data_received = false;
+  transport_.data(&data, &all_data_received);
+  DCHECK(all_data_received);
+
+  decoder_ = ImageDecoder::create(*data, ImageSource::AlphaPremultiplied,
+                                  ImageSource::GammaAndColorProfileIgnored);
+  if (!decoder_)
+    return false;
+  decoder_->setData(data, true);
+  size_t frame_count = decoder_->frameCount();
+  if (decoder_->failed() || !frame_count)
+    return false;
+
+  result->repetition_count = decoder_->repetitionCount();
+  for (size_t i = 0; i < frame_count; ++i) {
+    // Like ImageSource, show frames that ask for 10ms or less for 100ms, as
+    // other browsers do.
+    double duration_ms = decoder_->frameDurationAtIndex(i);
+    result->durations_ms.push_back(duration_ms < 11 ? 100 : duration_ms);
+  }
+  return true;
+}
+
+void CanvasAnimatedImage::Decoder::Decode(DecodeResult* result) {
+  TRACE_EVENT1("sky", "CanvasAnimatedImage::Decode", "frames",
+               result->indices.size());
+  if (!decoder_ && !Initialize(result)) {
+    result->failed = true;
+    return;
+  }
+
+  for (size_t index : result->indices) {
+    ImageFrame* frame = decoder_->frameBufferAtIndex(index);
+    if (!frame || frame->status() != ImageFrame::FrameComplete) {
+      result->bitmaps.push_back(SkBitmap());
+      continue;
+    }
+    // The bitmap keeps the frame's pixels alive, so the decoder only needs
+    // to hold on to the frame that the next one may be drawn on top of.
+    result->bitmaps.push_back(frame->getSkBitmap());
+    decoder_->clearCacheExceptFrame(index);
+  }
+}
+
+PassRefPtr<CanvasAnimatedImage> CanvasAnimatedImage::create(
+    mojo::ScopedDataPipeConsumerHandle handle,
+    PassOwnPtr<AnimatedImageCallback> callback) {
+  return adoptRef(new CanvasAnimatedImage(handle.Pass(), callback));
+}
+
+CanvasAnimatedImage::CanvasAnimatedImage(
+    mojo::ScopedDataPipeConsumerHandle handle,
+    PassOwnPtr<AnimatedImageCallback> callback)
+    : callback_(callback),
+      repetition_count_(cAnimationNone),
+      current_frame_(0),
+      next_frame_(0),
+      decode_pending_(false),
+      weak_factory_(this) {
+  CHECK(callback_);
+  if (!handle.is_valid()) {
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(&CanvasAnimatedImage::RejectCallback,
+                              weak_factory_.GetWeakPtr()));
+    return;
+  }
+
+  buffer_ = SharedBuffer::create();
+  drainer_ = adoptPtr(new mojo::common::DataPipeDrainer(this, handle.Pass()));
+}
+
+CanvasAnimatedImage::~CanvasAnimatedImage() {
+}
+
+int CanvasAnimatedImage::repetitionCount() const {
+  if (repetition_count_ == cAnimationNone)
+    return 0;
+  return repetition_count_;
+}
+
+PassRefPtr<CanvasImage> CanvasAnimatedImage::frameAt(double time) {
+  if (frames_.isEmpty())
+    return nullptr;
+
+  size_t index = FrameIndexAt(time);
+  if (frames_[index].image)
+    current_frame_ = index;
+  if (index != next_frame_) {
+    next_frame_ = index;
+    for (size_t i = 0; i < frames_.size(); ++i) {
+      if (!IsInWindow(i))
+        frames_[i].image.clear();
+    }
+  }
+  DecodeAhead();
+  return frames_[current_frame_].image;
+}
+
+size_t CanvasAnimatedImage::FrameIndexAt(double time) const {
+  double pass_ms = frames_.last().end_ms;
+  if (frames_.size() == 1 || time <= 0 || !pass_ms)
+    return 0;
+
+  if (repetition_count_ != cAnimationLoopInfinite) {
+    double passes = std::max(repetition_count_, 0) + 1;
+    if (time >= pass_ms * passes)
+      return frames_.size() - 1;
+  }
+
+  double offset = fmod(time, pass_ms);
+  const Frame* frame = std::upper_bound(
+      frames_.begin(), frames_.end(), offset,
+      [](double offset, const Frame& frame) { return offset < frame.end_ms; });
+  return std::min<size_t>(frame - frames_.begin(), frames_.size() - 1);
+}
+
+bool CanvasAnimatedImage::IsInWindow(size_t index) const {
+  if (index == current_frame_)
+    return true;
+  size_t ahead = (index + frames_.size() - next_frame_) % frames_.size();
+  return ahead <= kFramesDecodedAhead;
+}
+
+std::vector<size_t> CanvasAnimatedImage::FramesToDecode() const {
+  std::vector<size_t> indices;
+  for (size_t i = 0; i <= kFramesDecodedAhead && i < frames_.size(); ++i) {
+    size_t index = (next_frame_ + i) % frames_.size();
+    if (!frames_[index].image && !frames_[index].failed)
+      indices.push_back(index);
+  }
+  return indices;
+}
+
+void CanvasAnimatedImage::DecodeAhead() {
+  if (decode_pending_ || !decoder_)
+    return;
+
+  std::vector<size_t> indices = FramesToDecode();
+  if (indices.empty())
+    return;
+  DecodeResult* result = new DecodeResult;
+  result->indices.swap(indices);
+  PostDecode(result);
+}
+
+void CanvasAnimatedImage::PostDecode(DecodeResult* result) {
+  DCHECK(!decode_pending_);
+  decode_pending_ = true;
+  base::WorkerPool::PostTaskAndReply(
+      FROM_HERE, base::Bind(&Decoder::Run, decoder_, result),
+      base::Bind(&CanvasAnimatedImage::OnDecoded, weak_factory_.GetWeakPtr(),
+                 base::Owned(result)),
+      true);
+}
+
+void CanvasAnimatedImage::OnDataAvailable(const void* data, size_t num_bytes) {
+  buffer_->append(static_cast<const char*>(data), num_bytes);
+}
+
+void CanvasAnimatedImage::OnDataComplete() {
+  decoder_ = Decoder::create();
+  decoder_->SetData(buffer_.get());
+  // The decoder has its own copy of the data.
+  buffer_.clear();
+
+  DecodeResult* result = new DecodeResult;
+  result->indices.push_back(0);
+  PostDecode(result);
+}
+
+void CanvasAnimatedImage::OnDecoded(DecodeResult* result) {
+  // The callback can run Dart code that drops the last reference to us.
+  RefPtr<CanvasAnimatedImage> protect(this);
+  decode_pending_ = false;
+
+  bool first_decode = frames_.isEmpty();
+  if (result->failed || (first_decode && result->bitmaps[0].isNull())) {
+    decoder_.clear();
+    if (first_decode)
+      RejectCallback();
+    return;
+  }
+
+  if (first_decode) {
+    repetition_count_ = result->repetition_count;
+    frames_.resize(result->durations_ms.size());
+    double end_ms = 0;
+    for (size_t i = 0; i < frames_.size(); ++i) {
+      end_ms += result->durations_ms[i];
+      frames_[i].end_ms = end_ms;
+    }
+  }
+
+  for (size_t i = 0; i < result->indices.size(); ++i) {
+    size_t index = result->indices[i];
+    if (result->bitmaps[i].isNull()) {
+      frames_[index].failed = true;
+      continue;
+    }
+    if (!IsInWindow(index))
+      continue;
+    frames_[index].image = CanvasImage::create();
+    frames_[index].image->setBitmap(result->bitmaps[i]);
+  }
+
+  if (first_decode) {
+    OwnPtr<AnimatedImageCallback> callback = callback_.release();
+    callback->handleEvent(this);
+  }
+  DecodeAhead();
+}
+
+void CanvasAnimatedImage::RejectCallback() {
+  OwnPtr<AnimatedImageCallback> callback = callback_.release();
+  callback->handleEvent(nullptr);
+}
+
+}  // namespace blink
@@ -0,0 +1,97 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_LOADER_CANVASANIMATEDIMAGE_H_
+#define SKY_ENGINE_CORE_LOADER_CANVASANIMATEDIMAGE_H_
+
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "mojo/common/data_pipe_drainer.h"
+#include "sky/engine/core/loader/AnimatedImageCallback.h"
+#include "sky/engine/core/painting/CanvasImage.h"
+#include "sky/engine/platform/SharedBuffer.h"
+#include "sky/engine/tonic/dart_wrappable.h"
+#include "sky/engine/wtf/OwnPtr.h"
+#include "sky/engine/wtf/Vector.h"
+
+namespace blink {
+
+// Reads an image, usually a GIF, from a data pipe and decodes its frames on a
+// worker thread as they are asked for. |callback| is passed the image once
+// the first frame is decoded, or null if it can't be decoded.
+//
+// Only the frame last returned by frameAt(), the frame it asked for and the
+// kFramesDecodedAhead frames after that are kept decoded, so memory use
+// doesn't grow with the length of the animation. A frame that fails to decode
+// is skipped, and the frame before it stays on screen.
+class CanvasAnimatedImage : public mojo::common::DataPipeDrainer::Client,
+                            public RefCounted<CanvasAnimatedImage>,
+                            public DartWrappable {
+  DEFINE_WRAPPERTYPEINFO();
+ public:
+  static PassRefPtr<CanvasAnimatedImage> create(
+      mojo::ScopedDataPipeConsumerHandle handle,
+      PassOwnPtr<AnimatedImageCallback> callback);
+  ~CanvasAnimatedImage() override;
+
+  int frameCount() const { return frames_.size(); }
+  int repetitionCount() const;
+
+  PassRefPtr<CanvasImage> frameAt(double time);
+
+  // mojo::common::DataPipeDrainer::Client
+  void OnDataAvailable(const void*, size_t) override;
+  void OnDataComplete() override;
+
+ private:
+  friend class CanvasAnimatedImageTest;
+
+  class Decoder;
+  struct DecodeResult;
+
+  struct Frame {
+    Frame() : end_ms(0), failed(false) {}
+
+    // The time from the start of a pass through the animation to the end of
+    // this frame.
+    double end_ms;
+    RefPtr<CanvasImage> image;
+    // The decoder had all the data when this frame failed, so it isn't
+    // decoded again.
+    bool failed;
+  };
+
+  static const size_t kFramesDecodedAhead = 3;
+
+  CanvasAnimatedImage(mojo::ScopedDataPipeConsumerHandle handle,
+                      PassOwnPtr<AnimatedImageCallback> callback);
+
+  size_t FrameIndexAt(double time) const;
+  bool IsInWindow(size_t index) const;
+  std::vector<size_t> FramesToDecode() const;
+  void DecodeAhead();
+  void PostDecode(DecodeResult* result);
+  void OnDecoded(DecodeResult* result);
+  void RejectCallback();
+
+  OwnPtr<mojo::common::DataPipeDrainer> drainer_;
+  RefPtr<SharedBuffer> buffer_;
+  OwnPtr<AnimatedImageCallback> callback_;
+
+  RefPtr<Decoder> decoder_;
+  Vector<Frame> frames_;
+  int repetition_count_;
+  // The frame last returned by frameAt().
+  size_t current_frame_;
+  // The frame last asked for, which may not be decoded yet.
+  size_t next_frame_;
+  bool decode_pending_;
+
+  base::WeakPtrFactory<CanvasAnimatedImage> weak_factory_;
+};
+
+}  // namespace blink
+
+#endif  // SKY_ENGINE_CORE_LOADER_CANVASANIMATEDIMAGE_H_
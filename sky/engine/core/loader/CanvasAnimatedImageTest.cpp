@@ -0,0 +1,122 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/loader/CanvasAnimatedImage.h"
+
+#include "base/message_loop/message_loop.h"
+#include "sky/engine/wtf/PassOwnPtr.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+const size_t kFrameCount = 6;
+const double kFrameDurationMs = 100;
+
+class CountingCallback : public AnimatedImageCallback {
+public:
+    explicit CountingCallback(int* calls) : m_calls(calls) { }
+    virtual void handleEvent(CanvasAnimatedImage*) override { ++*m_calls; }
+
+private:
+    int* m_calls;
+};
+
+SkBitmap decodedBitmap()
+{
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(1, 1);
+    return bitmap;
+}
+
+} // namespace
+
+// Feeds decode results to an image as if they came from its worker thread. The
+// image has no decoder, so it never starts a decode itself.
+class CanvasAnimatedImageTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_callbackCalls = 0;
+        m_image = CanvasAnimatedImage::create(mojo::ScopedDataPipeConsumerHandle(), adoptPtr(new CountingCallback(&m_callbackCalls)));
+    }
+
+    // Decodes |indices|, failing those in |failed|.
+    void decode(const std::vector<size_t>& indices, const std::vector<size_t>& failed)
+    {
+        CanvasAnimatedImage::DecodeResult result;
+        result.indices = indices;
+        if (m_image->frames_.isEmpty()) {
+            result.repetition_count = cAnimationLoopInfinite;
+            result.durations_ms.assign(kFrameCount, kFrameDurationMs);
+        }
+        for (size_t index : indices) {
+            bool fails = std::find(failed.begin(), failed.end(), index) != failed.end();
+            result.bitmaps.push_back(fails ? SkBitmap() : decodedBitmap());
+        }
+        m_image->OnDecoded(&result);
+    }
+
+    std::vector<size_t> framesToDecode() const { return m_image->FramesToDecode(); }
+    bool isDecoded(size_t index) const { return m_image->frames_[index].image.get(); }
+
+    // The posted callback rejection never runs, since the loop doesn't.
+    base::MessageLoop m_messageLoop;
+    int m_callbackCalls;
+    RefPtr<CanvasAnimatedImage> m_image;
+};
+
+namespace {
+
+std::vector<size_t> indices(size_t first, size_t last)
+{
+    std::vector<size_t> result;
+    for (size_t i = first; i <= last; ++i)
+        result.push_back(i);
+    return result;
+}
+
+TEST_F(CanvasAnimatedImageTest, FirstFrameReportsTheImageAndDecodesAhead)
+{
+    decode(indices(0, 0), std::vector<size_t>());
+    EXPECT_EQ(1, m_callbackCalls);
+    EXPECT_EQ(static_cast<int>(kFrameCount), m_image->frameCount());
+    EXPECT_EQ(indices(1, 3), framesToDecode());
+}
+
+TEST_F(CanvasAnimatedImageTest, FailedFramesAreNotDecodedAgain)
+{
+    decode(indices(0, 0), std::vector<size_t>());
+    decode(indices(1, 3), indices(1, 1));
+    EXPECT_FALSE(isDecoded(1));
+    EXPECT_TRUE(isDecoded(2));
+    EXPECT_TRUE(framesToDecode().empty());
+
+    // Moving on to the failed frame keeps the last frame on screen and only
+    // asks for the frame that came into the window.
+    RefPtr<CanvasImage> frame = m_image->frameAt(kFrameDurationMs * 1.5);
+    EXPECT_TRUE(frame.get());
+    EXPECT_TRUE(isDecoded(0));
+    EXPECT_EQ(indices(4, 4), framesToDecode());
+}
+
+TEST_F(CanvasAnimatedImageTest, FramesOutsideTheWindowAreDropped)
+{
+    decode(indices(0, 0), std::vector<size_t>());
+    decode(indices(1, 3), std::vector<size_t>());
+
+    m_image->frameAt(kFrameDurationMs * 3.5);
+    EXPECT_FALSE(isDecoded(1));
+    EXPECT_FALSE(isDecoded(2));
+    EXPECT_TRUE(isDecoded(3));
+    EXPECT_EQ(indices(4, 5), framesToDecode());
+}
+
+} // namespace
+
+} // namespace blink
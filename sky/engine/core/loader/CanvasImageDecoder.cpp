@@ -4,13 +4,103 @@
 
 #include "base/bind.h"
 #include "base/message_loop/message_loop.h"
+#include "base/threading/worker_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "sky/engine/core/loader/CanvasImageDecoder.h"
 #include "sky/engine/core/painting/CanvasImage.h"
 #include "sky/engine/platform/SharedBuffer.h"
+#include "sky/engine/platform/graphics/ThreadSafeDataTransport.h"
 #include "sky/engine/platform/image-decoders/ImageDecoder.h"
+#include "sky/engine/wtf/ThreadSafeRefCounted.h"
 
 namespace blink {
 
+struct CanvasImageDecoder::DecodeResult {
+  enum Status {
+    // Not enough data has arrived to decode any of the image.
+    kNeedMoreData,
+    kPartial,
+    kComplete,
+    kFailed,
+  };
+
+  DecodeResult() : status(kNeedMoreData) {}
+
+  Status status;
+  SkBitmap bitmap;
+};
+
+// Owns the ImageDecoder. The data is handed over on the main thread and
+// decoded on a worker thread, by one decode task at a time.
+class CanvasImageDecoder::Decoder : public ThreadSafeRefCounted<Decoder> {
+ public:
+  static PassRefPtr<Decoder> create() { return adoptRef(new Decoder); }
+
+  void SetData(SharedBuffer* buffer, bool all_data_received) {
+    transport_.setData(buffer, all_data_received);
+  }
+
+  // Runs on a worker thread.
+  static void Run(const RefPtr<Decoder>& decoder, DecodeResult* result) {
+    decoder->Decode(result);
+  }
+
+ private:
+  Decoder() {}
+
+  void Decode(DecodeResult* result);
+
+  ThreadSafeDataTransport transport_;
+  OwnPtr<ImageDecoder> decoder_;
+};
+
+void CanvasImageDecoder::Decoder::Decode(DecodeResult* result) {
+  TRACE_EVENT0("sky", "CanvasImageDecoder::Decode");
+  SharedBuffer* data = nullptr;
+  bool all_data_received = false;
+  transport_.data(&data, &all_data_received);
+
+  if (!decoder_) {
+    // The decoder can be null if there is too little data to guess what type
+    // of image to decode, or the type isn't supported.
+    decoder_ = ImageDecoder::create(*data, ImageSource::AlphaPremultiplied,
+                                    ImageSource::GammaAndColorProfileIgnored);
+    if (!decoder_) {
+      if (all_data_received)
+        result->status = DecodeResult::kFailed;
+      return;
+    }
+  }
+
+  decoder_->setData(data, all_data_received);
+  if (decoder_->failed() ||
+      (all_data_received && decoder_->frameCount() == 0)) {
+    result->status = DecodeResult::kFailed;
+    return;
+  }
+
+  ImageFrame* frame =
+      decoder_->frameCount() ? decoder_->frameBufferAtIndex(0) : nullptr;
+  if (all_data_received ||
+      (frame && frame->status() == ImageFrame::FrameComplete)) {
+    if (frame) {
+      result->status = DecodeResult::kComplete;
+      result->bitmap = frame->getSkBitmap();
+    } else {
+      result->status = DecodeResult::kFailed;
+    }
+    decoder_.clear();
+    return;
+  }
+
+  if (!frame || frame->status() == ImageFrame::FrameEmpty)
+    return;
+  // The decoder keeps writing to the frame's pixels as more data arrives, so
+  // the partial image gets its own copy.
+  if (frame->getSkBitmap().copyTo(&result->bitmap))
+    result->status = DecodeResult::kPartial;
+}
+
 PassRefPtr<CanvasImageDecoder> CanvasImageDecoder::create(
     mojo::ScopedDataPipeConsumerHandle handle,
     PassOwnPtr<ImageDecoderCallback> callback) {
@@ -20,7 +110,11 @@ PassRefPtr<CanvasImageDecoder> CanvasImageDecoder::create(
 CanvasImageDecoder::CanvasImageDecoder(
     mojo::ScopedDataPipeConsumerHandle handle,
     PassOwnPtr<ImageDecoderCallback> callback)
-    : callback_(callback), weak_factory_(this) {
+    : callback_(callback),
+      data_complete_(false),
+      decode_pending_(false),
+      needs_decode_(false),
+      weak_factory_(this) {
   CHECK(callback_);
   if (!handle.is_valid()) {
     base::MessageLoop::current()->PostTask(
@@ -30,35 +124,86 @@ CanvasImageDecoder::CanvasImageDecoder(
   }
 
   buffer_ = SharedBuffer::create();
+  decoder_ = Decoder::create();
   drainer_ = adoptPtr(new mojo::common::DataPipeDrainer(this, handle.Pass()));
 }
 
 CanvasImageDecoder::~CanvasImageDecoder() {
 }
 
+void CanvasImageDecoder::setProgressCallback(
+    PassOwnPtr<ImageDecoderCallback> callback) {
+  progress_callback_ = callback;
+  if (decoder_ && !data_complete_ && buffer_->size()) {
+    decoder_->SetData(buffer_.get(), false);
+    ScheduleDecode();
+  }
+}
+
 void CanvasImageDecoder::OnDataAvailable(const void* data, size_t num_bytes) {
   buffer_->append(static_cast<const char*>(data), num_bytes);
+  if (progress_callback_ && decoder_) {
+    decoder_->SetData(buffer_.get(), false);
+    ScheduleDecode();
+  }
 }
 
 void CanvasImageDecoder::OnDataComplete() {
-  OwnPtr<ImageDecoder> decoder =
-      ImageDecoder::create(*buffer_.get(), ImageSource::AlphaPremultiplied,
-                           ImageSource::GammaAndColorProfileIgnored);
-  // decoder can be null if the buffer we was empty and we couldn't even guess
-  // what type of image to decode.
-  if (!decoder) {
-    callback_->handleEvent(nullptr);
+  data_complete_ = true;
+  // The decoder is gone if the image already failed to decode.
+  if (!decoder_)
     return;
-  }
-  decoder->setData(buffer_.get(), true);
-  if (decoder->failed() || decoder->frameCount() == 0) {
-    callback_->handleEvent(nullptr);
+  decoder_->SetData(buffer_.get(), true);
+  ScheduleDecode();
+}
+
+void CanvasImageDecoder::ScheduleDecode() {
+  if (decode_pending_) {
+    needs_decode_ = true;
     return;
   }
+  decode_pending_ = true;
+  needs_decode_ = false;
+  DecodeResult* result = new DecodeResult;
+  base::WorkerPool::PostTaskAndReply(
+      FROM_HERE, base::Bind(&Decoder::Run, decoder_, result),
+      base::Bind(&CanvasImageDecoder::OnDecoded, weak_factory_.GetWeakPtr(),
+                 base::Owned(result)),
+      true);
+}
+
+void CanvasImageDecoder::OnDecoded(DecodeResult* result) {
+  // The callbacks can run Dart code that drops the last reference to us.
+  RefPtr<CanvasImageDecoder> protect(this);
+  decode_pending_ = false;
+  switch (result->status) {
+    case DecodeResult::kFailed:
+      Finish(nullptr);
+      return;
+    case DecodeResult::kComplete: {
+      RefPtr<CanvasImage> image = CanvasImage::create();
+      image->setBitmap(result->bitmap);
+      Finish(image.get());
+      return;
+    }
+    case DecodeResult::kPartial:
+      if (progress_callback_) {
+        RefPtr<CanvasImage> image = CanvasImage::create();
+        image->setBitmap(result->bitmap);
+        progress_callback_->handleEvent(image.get());
+      }
+      break;
+    case DecodeResult::kNeedMoreData:
+      break;
+  }
+  if (needs_decode_ && decoder_)
+    ScheduleDecode();
+}
 
-  RefPtr<CanvasImage> resultImage = CanvasImage::create();
-  resultImage->setBitmap(decoder->frameBufferAtIndex(0)->getSkBitmap());
-  callback_->handleEvent(resultImage.get());
+void CanvasImageDecoder::Finish(CanvasImage* image) {
+  decoder_.clear();
+  progress_callback_.clear();
+  callback_->handleEvent(image);
 }
 
 void CanvasImageDecoder::RejectCallback() {
@@ -16,6 +16,10 @@
 
 namespace blink {
 
+// Decodes the image read from a data pipe on a worker thread and passes it to
+// |callback|, or null if it can't be decoded. If a progress callback is set,
+// the bytes are also decoded as they arrive, and the progress callback gets a
+// copy of the partially decoded image each time more of it is available.
 class CanvasImageDecoder : public mojo::common::DataPipeDrainer::Client,
                            public RefCounted<CanvasImageDecoder>,
                            public DartWrappable {
@@ -24,18 +28,36 @@ class CanvasImageDecoder : public mojo::common::DataPipeDrainer::Client,
   static PassRefPtr<CanvasImageDecoder> create(mojo::ScopedDataPipeConsumerHandle handle, PassOwnPtr<ImageDecoderCallback> callback);
   virtual ~CanvasImageDecoder();
 
+  void setProgressCallback(PassOwnPtr<ImageDecoderCallback> callback);
+
   // mojo::common::DataPipeDrainer::Client
   void OnDataAvailable(const void*, size_t) override;
   void OnDataComplete() override;
 
  private:
+  friend class CanvasImageDecoderTest;
+
+  class Decoder;
+  struct DecodeResult;
+
   CanvasImageDecoder(mojo::ScopedDataPipeConsumerHandle handle, PassOwnPtr<ImageDecoderCallback> callback);
 
+  void ScheduleDecode();
+  void OnDecoded(DecodeResult* result);
+  void Finish(CanvasImage* image);
   void RejectCallback();
 
   OwnPtr<mojo::common::DataPipeDrainer> drainer_;
   RefPtr<SharedBuffer> buffer_;
   OwnPtr<ImageDecoderCallback> callback_;
+  OwnPtr<ImageDecoderCallback> progress_callback_;
+
+  // Null once the image has been passed to |callback_|.
+  RefPtr<Decoder> decoder_;
+  bool data_complete_;
+  bool decode_pending_;
+  // Set if more data arrived while a decode was running.
+  bool needs_decode_;
 
   base::WeakPtrFactory<CanvasImageDecoder> weak_factory_;
 };
@@ -0,0 +1,183 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/loader/CanvasImageDecoder.h"
+
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/threading/platform_thread.h"
+#include "sky/engine/core/painting/CanvasImage.h"
+#include "sky/engine/platform/image-encoders/skia/PNGImageEncoder.h"
+#include "sky/engine/wtf/PassOwnPtr.h"
+#include "sky/engine/wtf/Vector.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+const int kImageSize = 64;
+
+class RecordingCallback : public ImageDecoderCallback {
+public:
+    explicit RecordingCallback(Vector<RefPtr<CanvasImage>>* images) : m_images(images) { }
+    virtual void handleEvent(CanvasImage* image) override { m_images->append(image); }
+
+private:
+    Vector<RefPtr<CanvasImage>>* m_images;
+};
+
+// A PNG of noise, which compresses so poorly that a prefix of it holds a
+// prefix of its rows.
+Vector<unsigned char> noisyPNG()
+{
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(kImageSize, kImageSize);
+    uint32_t state = 1;
+    for (int y = 0; y < kImageSize; ++y) {
+        for (int x = 0; x < kImageSize; ++x) {
+            state = state * 1103515245 + 12345;
+            *bitmap.getAddr32(x, y) = state | 0xFF000000;
+        }
+    }
+    Vector<unsigned char> png;
+    PNGImageEncoder::encode(bitmap, &png);
+    return png;
+}
+
+} // namespace
+
+// Feeds bytes to a decoder as its data pipe drainer would. The decoder has no
+// pipe, so it only decodes what the test hands it, on the worker pool.
+class CanvasImageDecoderTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_decoder = CanvasImageDecoder::create(mojo::ScopedDataPipeConsumerHandle(), adoptPtr(new RecordingCallback(&m_images)));
+        // Drop the rejection posted for the missing pipe, and decode as if
+        // there had been one.
+        m_decoder->weak_factory_.InvalidateWeakPtrs();
+        m_decoder->buffer_ = SharedBuffer::create();
+        m_decoder->decoder_ = CanvasImageDecoder::Decoder::create();
+    }
+
+    void setProgressCallback()
+    {
+        m_decoder->setProgressCallback(adoptPtr(new RecordingCallback(&m_partialImages)));
+    }
+
+    void append(const Vector<unsigned char>& data, size_t begin, size_t end)
+    {
+        m_decoder->OnDataAvailable(data.data() + begin, end - begin);
+    }
+
+    bool decodePending() const { return m_decoder->decode_pending_; }
+    bool decodeRequestedWhilePending() const { return m_decoder->needs_decode_; }
+
+    // Runs until the decoder has no decode running or queued.
+    void waitForDecodes()
+    {
+        while (m_decoder->decode_pending_) {
+            base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(1));
+            base::RunLoop().RunUntilIdle();
+        }
+    }
+
+    base::MessageLoop m_messageLoop;
+    Vector<RefPtr<CanvasImage>> m_images;
+    Vector<RefPtr<CanvasImage>> m_partialImages;
+    RefPtr<CanvasImageDecoder> m_decoder;
+};
+
+namespace {
+
+TEST_F(CanvasImageDecoderTest, DecodesOnceAllDataHasArrived)
+{
+    Vector<unsigned char> png = noisyPNG();
+    append(png, 0, png.size() / 2);
+    EXPECT_FALSE(decodePending());
+
+    append(png, png.size() / 2, png.size());
+    m_decoder->OnDataComplete();
+    waitForDecodes();
+
+    ASSERT_EQ(1u, m_images.size());
+    ASSERT_TRUE(m_images[0]);
+    EXPECT_EQ(kImageSize, m_images[0]->width());
+    EXPECT_EQ(kImageSize, m_images[0]->height());
+}
+
+TEST_F(CanvasImageDecoderTest, ReportsPartialThenCompleteImages)
+{
+    setProgressCallback();
+    Vector<unsigned char> png = noisyPNG();
+    append(png, 0, png.size() / 2);
+    waitForDecodes();
+
+    ASSERT_EQ(1u, m_partialImages.size());
+    ASSERT_TRUE(m_partialImages[0]);
+    EXPECT_EQ(kImageSize, m_partialImages[0]->width());
+    EXPECT_TRUE(m_images.isEmpty());
+
+    append(png, png.size() / 2, png.size());
+    m_decoder->OnDataComplete();
+    waitForDecodes();
+
+    ASSERT_EQ(1u, m_images.size());
+    ASSERT_TRUE(m_images[0]);
+    EXPECT_EQ(kImageSize, m_images[0]->width());
+    // The final image doesn't also go to the progress callback.
+    size_t partialImages = m_partialImages.size();
+    EXPECT_LE(partialImages, 2u);
+    base::RunLoop().RunUntilIdle();
+    EXPECT_EQ(partialImages, m_partialImages.size());
+}
+
+TEST_F(CanvasImageDecoderTest, CoalescesDecodesRequestedWhileOneRuns)
+{
+    setProgressCallback();
+    Vector<unsigned char> png = noisyPNG();
+    size_t chunk = png.size() / 4;
+    append(png, 0, chunk);
+    EXPECT_TRUE(decodePending());
+    EXPECT_FALSE(decodeRequestedWhilePending());
+
+    // The decode on the worker can't reply until the loop runs, so these
+    // chunks arrive while it is still pending.
+    append(png, chunk, chunk * 2);
+    append(png, chunk * 2, chunk * 3);
+    EXPECT_TRUE(decodeRequestedWhilePending());
+    waitForDecodes();
+
+    // One decode for the first chunk and one for both of the others.
+    EXPECT_LE(m_partialImages.size(), 2u);
+    EXPECT_FALSE(decodeRequestedWhilePending());
+    EXPECT_TRUE(m_images.isEmpty());
+}
+
+TEST_F(CanvasImageDecoderTest, ReportsNullForUndecodableData)
+{
+    setProgressCallback();
+    const char garbage[] = "this is not an image, just some text";
+    m_decoder->OnDataAvailable(garbage, sizeof(garbage));
+    waitForDecodes();
+    EXPECT_TRUE(m_images.isEmpty());
+
+    m_decoder->OnDataComplete();
+    waitForDecodes();
+
+    ASSERT_EQ(1u, m_images.size());
+    EXPECT_FALSE(m_images[0]);
+    EXPECT_TRUE(m_partialImages.isEmpty());
+
+    // Later data is ignored once the callback has its answer.
+    m_decoder->OnDataAvailable(garbage, sizeof(garbage));
+    EXPECT_FALSE(decodePending());
+}
+
+} // namespace
+
+} // namespace blink
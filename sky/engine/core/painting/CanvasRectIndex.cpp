@@ -0,0 +1,59 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/painting/CanvasRectIndex.h"
+
+namespace blink {
+
+CanvasRectIndex::CanvasRectIndex()
+    : m_length(0)
+{
+}
+
+CanvasRectIndex::~CanvasRectIndex()
+{
+}
+
+unsigned CanvasRectIndex::add(const Rect& rect)
+{
+    if (!rect.is_null) {
+        m_index.add(rect.sk_rect);
+        m_numbers.append(m_length);
+    }
+    return m_length++;
+}
+
+void CanvasRectIndex::clear()
+{
+    m_index.clear();
+    m_numbers.clear();
+    m_length = 0;
+}
+
+Vector<unsigned> CanvasRectIndex::hitTest(const Point& point)
+{
+    if (point.is_null)
+        return Vector<unsigned>();
+    return find(FloatRect(point.sk_point.x(), point.sk_point.y(), 0, 0));
+}
+
+Vector<unsigned> CanvasRectIndex::query(const Rect& rect)
+{
+    if (rect.is_null)
+        return Vector<unsigned>();
+    return find(FloatRect(rect.sk_rect));
+}
+
+Vector<unsigned> CanvasRectIndex::find(const FloatRect& rect)
+{
+    Vector<size_t> matches;
+    m_index.query(rect, matches);
+    Vector<unsigned> result;
+    result.reserveInitialCapacity(matches.size());
+    for (size_t match : matches)
+        result.uncheckedAppend(m_numbers[match]);
+    return result;
+}
+
+} // namespace blink
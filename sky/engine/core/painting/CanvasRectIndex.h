@@ -0,0 +1,52 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_PAINTING_CANVASRECTINDEX_H_
+#define SKY_ENGINE_CORE_PAINTING_CANVASRECTINDEX_H_
+
+#include "sky/engine/core/painting/Point.h"
+#include "sky/engine/core/painting/Rect.h"
+#include "sky/engine/platform/geometry/RectIndex.h"
+#include "sky/engine/tonic/dart_wrappable.h"
+#include "sky/engine/wtf/PassRefPtr.h"
+#include "sky/engine/wtf/RefCounted.h"
+#include "sky/engine/wtf/Vector.h"
+
+// This is CanvasRectIndex rather than RectIndex because of the class in
+// ../../platform/geometry/RectIndex.h, which does the work.
+
+namespace blink {
+
+class CanvasRectIndex : public RefCounted<CanvasRectIndex>, public DartWrappable {
+    DEFINE_WRAPPERTYPEINFO();
+public:
+    ~CanvasRectIndex() override;
+    static PassRefPtr<CanvasRectIndex> create()
+    {
+        return adoptRef(new CanvasRectIndex);
+    }
+
+    unsigned length() const { return m_length; }
+
+    unsigned add(const Rect& rect);
+    void clear();
+
+    Vector<unsigned> hitTest(const Point& point);
+    Vector<unsigned> query(const Rect& rect);
+
+private:
+    CanvasRectIndex();
+
+    Vector<unsigned> find(const FloatRect& rect);
+
+    RectIndex m_index;
+    // The number each rect in |m_index| was given by add(). Null rects get a
+    // number but aren't indexed, so nothing finds them.
+    Vector<unsigned> m_numbers;
+    unsigned m_length;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_PAINTING_CANVASRECTINDEX_H_
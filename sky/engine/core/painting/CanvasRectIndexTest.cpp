@@ -0,0 +1,73 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/painting/CanvasRectIndex.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+Rect makeRect(float left, float top, float right, float bottom)
+{
+    Rect rect;
+    rect.sk_rect = SkRect::MakeLTRB(left, top, right, bottom);
+    rect.is_null = false;
+    return rect;
+}
+
+Rect nullRect()
+{
+    Rect rect;
+    rect.sk_rect = SkRect::MakeEmpty();
+    rect.is_null = true;
+    return rect;
+}
+
+Point makePoint(float x, float y)
+{
+    Point point;
+    point.sk_point = SkPoint::Make(x, y);
+    point.is_null = false;
+    return point;
+}
+
+TEST(CanvasRectIndexTest, NullRectsAreNumberedButNeverFound)
+{
+    RefPtr<CanvasRectIndex> index = CanvasRectIndex::create();
+    EXPECT_EQ(0u, index->add(nullRect()));
+    EXPECT_EQ(1u, index->add(makeRect(-2, -2, 2, 2)));
+    EXPECT_EQ(2u, index->add(nullRect()));
+    EXPECT_EQ(3u, index->add(makeRect(-1, -1, 0, 0)));
+    EXPECT_EQ(4u, index->length());
+
+    Vector<unsigned> hits = index->hitTest(makePoint(-1, -1));
+    ASSERT_EQ(2u, hits.size());
+    EXPECT_EQ(1u, hits[0]);
+    EXPECT_EQ(3u, hits[1]);
+
+    hits = index->query(makeRect(-10, -10, 10, 10));
+    ASSERT_EQ(2u, hits.size());
+    EXPECT_EQ(1u, hits[0]);
+    EXPECT_EQ(3u, hits[1]);
+}
+
+TEST(CanvasRectIndexTest, ClearRestartsNumbering)
+{
+    RefPtr<CanvasRectIndex> index = CanvasRectIndex::create();
+    index->add(nullRect());
+    index->add(makeRect(0, 0, 10, 10));
+    index->clear();
+    EXPECT_EQ(0u, index->length());
+
+    EXPECT_EQ(0u, index->add(makeRect(0, 0, 10, 10)));
+    Vector<unsigned> hits = index->hitTest(makePoint(5, 5));
+    ASSERT_EQ(1u, hits.size());
+    EXPECT_EQ(0u, hits[0]);
+}
+
+} // namespace
+
+} // namespace blink
@@ -62,12 +62,17 @@ COMPILE_ASSERT(sizeof(InlineTextBox) == sizeof(SameSizeAsInlineTextBox), InlineT
 typedef WTF::HashMap<const InlineTextBox*, LayoutRect> InlineTextBoxOverflowMap;
 static InlineTextBoxOverflowMap* gTextBoxesWithOverflow;
 
+// The glyphs layout shaped for a box, kept until paint draws them.
+typedef WTF::HashMap<const InlineTextBox*, OwnPtr<GlyphBuffer> > InlineTextBoxGlyphsMap;
+static InlineTextBoxGlyphsMap* gGlyphsFromLayout;
+
 static const int misspellingLineThickness = 3;
 
 void InlineTextBox::destroy()
 {
     if (!knownToHaveNoOverflow() && gTextBoxesWithOverflow)
         gTextBoxesWithOverflow->remove(this);
+    clearGlyphsFromLayout();
     InlineBox::destroy();
 }
 
@@ -75,9 +80,32 @@ void InlineTextBox::markDirty()
 {
     m_len = 0;
     m_start = 0;
+    m_cachedTextBlob.clear();
+    clearGlyphsFromLayout();
     InlineBox::markDirty();
 }
 
+const GlyphBuffer* InlineTextBox::glyphsFromLayout() const
+{
+    if (!gGlyphsFromLayout)
+        return 0;
+    return gGlyphsFromLayout->get(this);
+}
+
+void InlineTextBox::setGlyphsFromLayout(PassOwnPtr<GlyphBuffer> glyphBuffer)
+{
+    if (!gGlyphsFromLayout)
+        gGlyphsFromLayout = new InlineTextBoxGlyphsMap;
+    gGlyphsFromLayout->set(this, glyphBuffer);
+    m_cachedTextBlob.clear();
+}
+
+void InlineTextBox::clearGlyphsFromLayout()
+{
+    if (gGlyphsFromLayout)
+        gGlyphsFromLayout->remove(this);
+}
+
 LayoutRect InlineTextBox::logicalOverflowRect() const
 {
     if (knownToHaveNoOverflow() || !gTextBoxesWithOverflow)
@@ -415,7 +443,7 @@ void paintText(GraphicsContext* context,
     const AtomicString& emphasisMark, int emphasisMarkOffset,
     int startOffset, int endOffset, int truncationPoint,
     const FloatPoint& textOrigin, const FloatRect& boxRect,
-    TextBlobPtr* cachedTextBlob = 0)
+    TextBlobPtr* cachedTextBlob = 0, const GlyphBuffer* shapedGlyphs = 0)
 {
     TextRunPaintInfo textRunPaintInfo(textRun);
     textRunPaintInfo.bounds = boxRect;
@@ -424,6 +452,7 @@ void paintText(GraphicsContext* context,
         textRunPaintInfo.to = endOffset;
         // FIXME: We should be able to use cachedTextBlob in more cases.
         textRunPaintInfo.cachedTextBlob = cachedTextBlob;
+        textRunPaintInfo.shapedGlyphs = shapedGlyphs;
         if (emphasisMark.isEmpty())
             context->drawText(font, textRunPaintInfo, textOrigin);
         else
@@ -461,11 +490,11 @@ inline void paintEmphasisMark(GraphicsContext* context,
 void paintTextWithEmphasisMark(
     GraphicsContext* context, const Font& font, const TextPaintingStyle& textStyle, const TextRun& textRun,
     const AtomicString& emphasisMark, int emphasisMarkOffset, int startOffset, int endOffset, int length,
-    const FloatPoint& textOrigin, const FloatRect& boxRect, TextBlobPtr* cachedTextBlob = 0)
+    const FloatPoint& textOrigin, const FloatRect& boxRect, TextBlobPtr* cachedTextBlob = 0, const GlyphBuffer* shapedGlyphs = 0)
 {
     GraphicsContextStateSaver stateSaver(*context, false);
     updateGraphicsContext(context, textStyle, stateSaver);
-    paintText(context, font, textRun, nullAtom, 0, startOffset, endOffset, length, textOrigin, boxRect, cachedTextBlob);
+    paintText(context, font, textRun, nullAtom, 0, startOffset, endOffset, length, textOrigin, boxRect, cachedTextBlob, shapedGlyphs);
 
     if (!emphasisMark.isEmpty()) {
         if (textStyle.emphasisMarkColor != textStyle.fillColor)
@@ -583,20 +612,25 @@ void InlineTextBox::paint(PaintInfo& paintInfo, const LayoutPoint& paintOffset,
         startOffset = ePos;
         endOffset = sPos;
     }
-    // FIXME: This cache should probably ultimately be held somewhere else.
-    // A hashmap is convenient to avoid a memory hit when the
-    // RuntimeEnabledFeature is off.
-    bool textBlobIsCacheable = RuntimeEnabledFeatures::textBlobEnabled() && startOffset == 0 && endOffset == length;
+    // The cached blob and the glyphs from layout cover the whole run, so
+    // they're only used to draw all of it.
+    bool canUseTextBlob = RuntimeEnabledFeatures::textBlobEnabled() && m_truncation == cNoTruncation && emphasisMark.isEmpty();
+    const GlyphBuffer* shapedGlyphs = m_truncation == cNoTruncation && emphasisMark.isEmpty() ? glyphsFromLayout() : 0;
+    bool textBlobIsCacheable = canUseTextBlob && startOffset == 0 && endOffset == length;
     TextBlobPtr* cachedTextBlob = textBlobIsCacheable ? &m_cachedTextBlob : nullptr;
-    paintTextWithEmphasisMark(context, font, textStyle, textRun, emphasisMark, emphasisMarkOffset, startOffset, endOffset, length, textOrigin, boxRect, cachedTextBlob);
+    paintTextWithEmphasisMark(context, font, textStyle, textRun, emphasisMark, emphasisMarkOffset, startOffset, endOffset, length, textOrigin, boxRect, cachedTextBlob, shapedGlyphs);
 
     if (paintSelectedTextSeparately && sPos < ePos) {
         // paint only the text that is selected
-        bool textBlobIsCacheable = RuntimeEnabledFeatures::textBlobEnabled() && sPos == 0 && ePos == length;
+        bool textBlobIsCacheable = canUseTextBlob && sPos == 0 && ePos == length;
         TextBlobPtr* cachedTextBlob = textBlobIsCacheable ? &m_cachedTextBlob : nullptr;
-        paintTextWithEmphasisMark(context, font, selectionStyle, textRun, emphasisMark, emphasisMarkOffset, sPos, ePos, length, textOrigin, boxRect, cachedTextBlob);
+        paintTextWithEmphasisMark(context, font, selectionStyle, textRun, emphasisMark, emphasisMarkOffset, sPos, ePos, length, textOrigin, boxRect, cachedTextBlob, shapedGlyphs);
     }
 
+    // Once the glyphs are in the box's blob, they're no longer needed.
+    if (shapedGlyphs && m_cachedTextBlob)
+        clearGlyphsFromLayout();
+
     // Paint decorations
     TextDecoration textDecorations = styleToUse->textDecorationsInEffect();
     if (textDecorations != TextDecorationNone) {
@@ -1288,6 +1322,57 @@ TextRun InlineTextBox::constructTextRun(RenderStyle* style, const Font& font, St
     return run;
 }
 
+bool InlineTextBox::canUseGlyphsFromLayout() const
+{
+    if (hasHyphen() || dirOverride())
+        return false;
+    // With tabs, the advances depend on where the run starts in the line.
+    RenderStyle* style = renderer().style(isFirstLineStyle());
+    return style->collapseWhiteSpace() && style->rtlOrdering() != VisualOrder;
+}
+
+bool InlineTextBox::paintsOnlyText(Color& fillColor)
+{
+    ASSERT(!isLineBreak() && m_len);
+    if (m_truncation != cNoTruncation || selectionState() != RenderObject::SelectionNone)
+        return false;
+
+    RenderStyle* styleToUse = renderer().style(isFirstLineStyle());
+    TextEmphasisPosition emphasisMarkPosition;
+    if (styleToUse->textDecorationsInEffect() != TextDecorationNone || getEmphasisMarkPosition(styleToUse, emphasisMarkPosition))
+        return false;
+
+    TextPaintingStyle textStyle = textPaintingStyle(renderer(), styleToUse);
+    if (textStyle.strokeWidth > 0 || textStyle.shadow)
+        return false;
+
+    if (renderer().node() && !renderer().document().markers().markersFor(renderer().node()).isEmpty())
+        return false;
+
+    fillColor = textStyle.fillColor;
+    return true;
+}
+
+bool InlineTextBox::appendTextToBlob(SkTextBlobBuilder& builder)
+{
+    RenderStyle* styleToUse = renderer().style(isFirstLineStyle());
+    const Font& font = styleToUse->font();
+
+    StringBuilder charactersWithHyphen;
+    TextRun textRun = constructTextRun(styleToUse, font, hasHyphen() ? &charactersWithHyphen : 0);
+    TextRunPaintInfo textRunPaintInfo(textRun);
+    textRunPaintInfo.shapedGlyphs = glyphsFromLayout();
+
+    // Matches the text origin that paint() computes from the box's origin.
+    FloatSize offset = locationIncludingFlipping() - root().locationIncludingFlipping();
+    FloatPoint textOrigin(offset.width(), offset.height() + font.fontMetrics().ascent());
+    if (!font.appendToTextBlob(textRunPaintInfo, textOrigin, builder))
+        return false;
+    // The line keeps the blob, so the glyphs are no longer needed.
+    clearGlyphsFromLayout();
+    return true;
+}
+
 TextRun InlineTextBox::constructTextRunForInspector(RenderStyle* style, const Font& font) const
 {
     return InlineTextBox::constructTextRun(style, font);
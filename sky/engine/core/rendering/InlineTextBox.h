@@ -135,11 +135,33 @@ public:
 
     void setExpansion(int newExpansion)
     {
+        // Justification moves the glyphs.
+        if (newExpansion != expansion()) {
+            m_cachedTextBlob.clear();
+            clearGlyphsFromLayout();
+        }
         m_logicalWidth -= expansion();
         InlineBox::setExpansion(newExpansion);
         m_logicalWidth += newExpansion;
     }
 
+    // Whether the run that layout measures for this box shapes into the same
+    // glyphs as the run paint draws, so layout can hand its glyphs to paint.
+    bool canUseGlyphsFromLayout() const;
+    // The glyphs are kept until the box's blob or its line's blob is built
+    // from them, or the box changes.
+    const GlyphBuffer* glyphsFromLayout() const;
+    void setGlyphsFromLayout(PassOwnPtr<GlyphBuffer>);
+    void clearGlyphsFromLayout();
+
+    // Whether paint() would draw nothing but the box's text in |fillColor|,
+    // so its line can draw it together with its neighbours.
+    bool paintsOnlyText(Color& fillColor);
+    // Adds the box's glyphs to |builder|, relative to the line's origin,
+    // using the glyphs from layout if the box still has them. Returns false if
+    // they can't be drawn from a blob.
+    bool appendTextToBlob(SkTextBlobBuilder&);
+
 private:
     virtual bool isInlineTextBox() const override final { return true; }
 
@@ -69,6 +69,10 @@ void RenderBox::willBeDestroyed()
 
 void RenderBox::destroyLayer()
 {
+    if (m_layer && !documentBeingDestroyed()) {
+        if (RenderView* renderView = view())
+            renderView->invalidateHitTestIndex();
+    }
     setHasLayer(false);
     m_layer = nullptr;
 }
@@ -79,6 +83,8 @@ void RenderBox::createLayer(LayerType type)
     m_layer = adoptPtr(new RenderLayer(this, type));
     setHasLayer(true);
     m_layer->insertOnlyThisLayer();
+    if (RenderView* renderView = view())
+        renderView->invalidateHitTestIndex();
 }
 
 bool RenderBox::hasSelfPaintingLayer() const
@@ -169,6 +175,9 @@ void RenderBox::updateTransform(const RenderStyle* oldStyle)
     if (oldStyle && style()->transformDataEquivalent(*oldStyle))
         return;
 
+    if (RenderView* renderView = view())
+        renderView->invalidateHitTestIndex();
+
     // hasTransform() on the renderer is also true when there is transform-style: preserve-3d or perspective set,
     // so check style too.
     bool localHasTransform = hasTransform() && style()->hasTransform();
@@ -670,7 +679,10 @@ bool RenderBox::hitTestLayer(RenderLayer* rootLayer, RenderLayer* containerLayer
     layers.reverse();
 
     bool hitLayer = false;
+    RenderView* renderView = view();
     for (auto& currentLayer : layers) {
+        if (!renderView->mayContainHitTestTarget(currentLayer))
+            continue;
         HitTestResult tempResult(result.hitTestLocation());
         bool localHitLayer = currentLayer->hitTestLayer(rootLayer, layer(), request, tempResult,
             localHitTestRect, localHitTestLocation, localTransformState.get(), zOffsetForDescendantsPtr);
@@ -76,6 +76,12 @@ RenderFlexibleBox::~RenderFlexibleBox()
 {
 }
 
+RenderFlexibleBox::LayoutStats& RenderFlexibleBox::layoutStats()
+{
+    DEFINE_STATIC_LOCAL(LayoutStats, stats, ());
+    return stats;
+}
+
 const char* RenderFlexibleBox::renderName() const
 {
     return "RenderFlexibleBox";
@@ -494,7 +500,7 @@ bool RenderFlexibleBox::childPreferredMainAxisContentExtentRequiresLayout(Render
     return preferredMainAxisExtentDependsOnLayout(flexBasisForChild(child), hasInfiniteLineLength) && hasOrthogonalFlow(child);
 }
 
-LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox* child, bool hasInfiniteLineLength, bool relayoutChildren)
+LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox* child, bool hasInfiniteLineLength)
 {
     child->clearOverrideSize();
 
@@ -502,13 +508,32 @@ LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox*
     if (preferredMainAxisExtentDependsOnLayout(flexBasis, hasInfiniteLineLength)) {
         LayoutUnit mainAxisExtent;
         if (hasOrthogonalFlow(child)) {
-            if (child->needsLayout() || relayoutChildren) {
-                m_intrinsicSizeAlongMainAxis.remove(child);
+            // The child's size along our main axis only depends on its
+            // subtree and the width it is laid out at, so a clean child that
+            // gets the same width doesn't need to be laid out to measure it,
+            // even if our own width changed.
+            LogicalExtentComputedValues computedValues;
+            child->computeLogicalWidth(computedValues);
+            IntrinsicSizeCacheEntry constraints;
+            constraints.crossAxisExtent = computedValues.m_extent;
+            constraints.stretched = alignmentForChild(child) == ItemPositionStretch;
+            HashMap<const RenderObject*, IntrinsicSizeCacheEntry>::iterator it = m_intrinsicSizeAlongMainAxis.find(child);
+            bool canUseCachedSize = it != m_intrinsicSizeAlongMainAxis.end()
+                && !child->needsLayout()
+                && !child->hasRelativeLogicalHeight()
+                && !child->needsPreferredWidthsRecalculation()
+                && it->value.crossAxisExtent == constraints.crossAxisExtent
+                && it->value.stretched == constraints.stretched;
+            if (canUseCachedSize) {
+                ++layoutStats().measureCacheHits;
+                mainAxisExtent = it->value.size;
+            } else {
+                ++layoutStats().measureCacheMisses;
                 child->forceChildLayout();
-                m_intrinsicSizeAlongMainAxis.set(child, child->logicalHeight());
+                constraints.size = child->logicalHeight();
+                m_intrinsicSizeAlongMainAxis.set(child, constraints);
+                mainAxisExtent = constraints.size;
             }
-            ASSERT(m_intrinsicSizeAlongMainAxis.contains(child));
-            mainAxisExtent = m_intrinsicSizeAlongMainAxis.get(child);
         } else {
             mainAxisExtent = child->maxPreferredLogicalWidth();
         }
@@ -532,7 +557,7 @@ void RenderFlexibleBox::layoutFlexItems(bool relayoutChildren)
     m_orderIterator.first();
     LayoutUnit crossAxisOffset = flowAwareBorderBefore() + flowAwarePaddingBefore();
     bool hasInfiniteLineLength = false;
-    while (computeNextFlexLine(orderedChildren, sumFlexBaseSize, totalFlexGrow, totalWeightedFlexShrink, sumHypotheticalMainSize, hasInfiniteLineLength, relayoutChildren)) {
+    while (computeNextFlexLine(orderedChildren, sumFlexBaseSize, totalFlexGrow, totalWeightedFlexShrink, sumHypotheticalMainSize, hasInfiniteLineLength)) {
         LayoutUnit containerMainInnerSize = mainAxisContentExtent(sumHypotheticalMainSize);
         LayoutUnit availableFreeSpace = containerMainInnerSize - sumFlexBaseSize;
         FlexSign flexSign = (sumHypotheticalMainSize < containerMainInnerSize) ? PositiveFlexibility : NegativeFlexibility;
@@ -732,7 +757,7 @@ LayoutUnit RenderFlexibleBox::adjustChildSizeForMinAndMax(RenderBox* child, Layo
     return std::max(childSize, minExtent);
 }
 
-bool RenderFlexibleBox::computeNextFlexLine(OrderedFlexItemList& orderedChildren, LayoutUnit& sumFlexBaseSize, double& totalFlexGrow, double& totalWeightedFlexShrink, LayoutUnit& sumHypotheticalMainSize, bool& hasInfiniteLineLength, bool relayoutChildren)
+bool RenderFlexibleBox::computeNextFlexLine(OrderedFlexItemList& orderedChildren, LayoutUnit& sumFlexBaseSize, double& totalFlexGrow, double& totalWeightedFlexShrink, LayoutUnit& sumHypotheticalMainSize, bool& hasInfiniteLineLength)
 {
     orderedChildren.clear();
     sumFlexBaseSize = 0;
@@ -753,7 +778,7 @@ bool RenderFlexibleBox::computeNextFlexLine(OrderedFlexItemList& orderedChildren
             continue;
         }
 
-        LayoutUnit childMainAxisExtent = preferredMainAxisContentExtentForChild(child, hasInfiniteLineLength, relayoutChildren);
+        LayoutUnit childMainAxisExtent = preferredMainAxisContentExtentForChild(child, hasInfiniteLineLength);
         LayoutUnit childMainAxisMarginBorderPadding = mainAxisBorderAndPaddingExtentForChild(child)
             + (isHorizontalFlow() ? child->marginWidth() : child->marginHeight());
         LayoutUnit childFlexBaseSize = childMainAxisExtent + childMainAxisMarginBorderPadding;
@@ -953,7 +978,8 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, cons
             // To avoid double applying margin changes in updateAutoMarginsInCrossAxis, we reset the margins here.
             resetAutoMarginsAndLogicalTopInCrossAxis(child);
         }
-        // We may have already forced relayout for orthogonal flowing children in preferredMainAxisContentExtentForChild.
+        // Orthogonal flowing children were either laid out in preferredMainAxisContentExtentForChild or are
+        // known not to need it, since their cached size was laid out with the same constraints.
         bool forceChildRelayout = relayoutChildren && !childPreferredMainAxisContentExtentRequiresLayout(child, hasInfiniteLineLength);
         updateBlockChildDirtyBitsBeforeLayout(forceChildRelayout, child);
         child->layoutIfNeeded();
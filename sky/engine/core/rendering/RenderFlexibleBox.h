@@ -54,6 +54,17 @@ public:
 
     bool isHorizontalFlow() const;
 
+    // Counts how often laying out a child to measure its main axis size could
+    // be skipped, across all flexboxes. FrameView resets the counts before
+    // each layout, so they cover the last one.
+    struct LayoutStats {
+        LayoutStats() : measureCacheHits(0), measureCacheMisses(0) { }
+
+        unsigned measureCacheHits;
+        unsigned measureCacheMisses;
+    };
+    static LayoutStats& layoutStats();
+
 protected:
     virtual void computeIntrinsicLogicalWidths(LayoutUnit& minLogicalWidth, LayoutUnit& maxLogicalWidth) const override;
 
@@ -113,7 +124,7 @@ private:
     void adjustAlignmentForChild(RenderBox* child, LayoutUnit);
     ItemPosition alignmentForChild(RenderBox* child) const;
     LayoutUnit mainAxisBorderAndPaddingExtentForChild(RenderBox* child) const;
-    LayoutUnit preferredMainAxisContentExtentForChild(RenderBox* child, bool hasInfiniteLineLength, bool relayoutChildren = false);
+    LayoutUnit preferredMainAxisContentExtentForChild(RenderBox* child, bool hasInfiniteLineLength);
     bool childPreferredMainAxisContentExtentRequiresLayout(RenderBox* child, bool hasInfiniteLineLength) const;
     bool needToStretchChildLogicalHeight(RenderBox* child) const;
 
@@ -134,7 +145,7 @@ private:
     void prepareOrderIteratorAndMargins();
     LayoutUnit adjustChildSizeForMinAndMax(RenderBox*, LayoutUnit childSize);
     // The hypothetical main size of an item is the flex base size clamped according to its min and max main size properties
-    bool computeNextFlexLine(OrderedFlexItemList& orderedChildren, LayoutUnit& sumFlexBaseSize, double& totalFlexGrow, double& totalWeightedFlexShrink, LayoutUnit& sumHypotheticalMainSize, bool& hasInfiniteLineLength, bool relayoutChildren);
+    bool computeNextFlexLine(OrderedFlexItemList& orderedChildren, LayoutUnit& sumFlexBaseSize, double& totalFlexGrow, double& totalWeightedFlexShrink, LayoutUnit& sumHypotheticalMainSize, bool& hasInfiniteLineLength);
 
     bool resolveFlexibleLengths(FlexSign, const OrderedFlexItemList&, LayoutUnit& availableFreeSpace, double& totalFlexGrow, double& totalWeightedFlexShrink, InflexibleFlexItemSize&, Vector<LayoutUnit, 16>& childSizes, bool hasInfiniteLineLength);
     void freezeViolations(const Vector<Violation>&, LayoutUnit& availableFreeSpace, double& totalFlexGrow, double& totalWeightedFlexShrink, InflexibleFlexItemSize&, bool hasInfiniteLineLength);
@@ -150,8 +161,19 @@ private:
     void flipForRightToLeftColumn();
     void flipForWrapReverse(const Vector<LineContext>&, LayoutUnit crossAxisStartEdge);
 
+    // The preferred size of an orthogonal flow child, together with the
+    // constraints it was laid out with. It stays valid while the child's
+    // subtree is clean and it gets the same constraints.
+    struct IntrinsicSizeCacheEntry {
+        IntrinsicSizeCacheEntry() : stretched(false) { }
+
+        LayoutUnit crossAxisExtent;
+        bool stretched;
+        LayoutUnit size;
+    };
+
     // This is used to cache the preferred size for orthogonal flow children so we don't have to relayout to get it
-    HashMap<const RenderObject*, LayoutUnit> m_intrinsicSizeAlongMainAxis;
+    HashMap<const RenderObject*, IntrinsicSizeCacheEntry> m_intrinsicSizeAlongMainAxis;
 
     mutable OrderIterator m_orderIterator;
     int m_numberOfInFlowChildrenOnFirstLine;
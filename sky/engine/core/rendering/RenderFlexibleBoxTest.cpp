@@ -0,0 +1,138 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/rendering/RenderFlexibleBox.h"
+
+#include "core/testing/DummyPageHolder.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/dom/Text.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+// Flexboxes are columns by default, so a child's height is measured by laying
+// it out, which is what the measure cache saves. The child's paragraph is
+// measured the same way whenever the child is laid out.
+class RenderFlexibleBoxTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_pageHolder = DummyPageHolder::create(IntSize(800, 600));
+        m_container = createContainer();
+        m_child = m_container->firstElementChild();
+    }
+
+    Document& document() { return m_pageHolder->document(); }
+
+    PassRefPtr<Element> createContainer()
+    {
+        RefPtr<Element> container = document().createElement("div", nullAtom, ASSERT_NO_EXCEPTION);
+        container->setInlineStyleProperty(CSSPropertyWidth, 100, CSSPrimitiveValue::CSS_PX);
+        RefPtr<Element> child = document().createElement("div", nullAtom, ASSERT_NO_EXCEPTION);
+        RefPtr<Element> paragraph = document().createElement("p", nullAtom, ASSERT_NO_EXCEPTION);
+        paragraph->appendChild(document().createText("some text that wraps onto several lines"), ASSERT_NO_EXCEPTION);
+        child->appendChild(paragraph, ASSERT_NO_EXCEPTION);
+        container->appendChild(child, ASSERT_NO_EXCEPTION);
+        document().appendChild(container, ASSERT_NO_EXCEPTION);
+        return container.release();
+    }
+
+    const RenderFlexibleBox::LayoutStats& layout()
+    {
+        document().updateLayout();
+        return RenderFlexibleBox::layoutStats();
+    }
+
+    static LayoutUnit height(Element* element) { return toRenderBox(element->renderer())->height(); }
+    static LayoutUnit width(Element* element) { return toRenderBox(element->renderer())->width(); }
+
+    OwnPtr<DummyPageHolder> m_pageHolder;
+    RefPtr<Element> m_container;
+    Element* m_child;
+};
+
+TEST_F(RenderFlexibleBoxTest, CleanChildKeepsItsMeasurement)
+{
+    layout();
+    LayoutUnit childHeight = height(m_child);
+
+    m_container->setInlineStyleProperty(CSSPropertyPaddingBottom, 5, CSSPrimitiveValue::CSS_PX);
+    const RenderFlexibleBox::LayoutStats& stats = layout();
+
+    EXPECT_EQ(1u, stats.measureCacheHits);
+    EXPECT_EQ(0u, stats.measureCacheMisses);
+    EXPECT_EQ(childHeight, height(m_child));
+}
+
+TEST_F(RenderFlexibleBoxTest, PaintOnlyChildStyleChangeKeepsItsMeasurement)
+{
+    layout();
+    LayoutUnit childHeight = height(m_child);
+
+    // The child's style changes without the child needing layout.
+    m_child->setInlineStyleProperty(CSSPropertyColor, "red");
+    m_container->setInlineStyleProperty(CSSPropertyPaddingBottom, 5, CSSPrimitiveValue::CSS_PX);
+    const RenderFlexibleBox::LayoutStats& stats = layout();
+
+    EXPECT_EQ(0u, stats.measureCacheMisses);
+    EXPECT_EQ(childHeight, height(m_child));
+}
+
+TEST_F(RenderFlexibleBoxTest, ChildStyleChangeRemeasures)
+{
+    layout();
+    m_child->setInlineStyleProperty(CSSPropertyFontSize, 30, CSSPrimitiveValue::CSS_PX);
+    const RenderFlexibleBox::LayoutStats& stats = layout();
+    EXPECT_LE(1u, stats.measureCacheMisses);
+
+    RefPtr<Element> fresh = createContainer();
+    fresh->firstElementChild()->setInlineStyleProperty(CSSPropertyFontSize, 30, CSSPrimitiveValue::CSS_PX);
+    layout();
+    EXPECT_EQ(height(fresh->firstElementChild()), height(m_child));
+}
+
+TEST_F(RenderFlexibleBoxTest, PercentageHeightChildRemeasures)
+{
+    m_container->setInlineStyleProperty(CSSPropertyHeight, 100, CSSPrimitiveValue::CSS_PX);
+    m_child->setInlineStyleProperty(CSSPropertyMinHeight, 50, CSSPrimitiveValue::CSS_PERCENTAGE);
+    layout();
+    EXPECT_EQ(LayoutUnit(50), height(m_child));
+
+    m_container->setInlineStyleProperty(CSSPropertyHeight, 300, CSSPrimitiveValue::CSS_PX);
+    const RenderFlexibleBox::LayoutStats& stats = layout();
+
+    EXPECT_LE(1u, stats.measureCacheMisses);
+    EXPECT_EQ(LayoutUnit(150), height(m_child));
+}
+
+TEST_F(RenderFlexibleBoxTest, OverrideWidthChangeRemeasures)
+{
+    // A stretched child is laid out at the container's width as an override
+    // width; one that isn't stretched shrinks to fit its content.
+    layout();
+    EXPECT_EQ(LayoutUnit(100), width(m_child));
+
+    m_child->setInlineStyleProperty(CSSPropertyAlignSelf, CSSValueFlexStart);
+    const RenderFlexibleBox::LayoutStats& stats = layout();
+    EXPECT_LE(1u, stats.measureCacheMisses);
+
+    RefPtr<Element> fresh = createContainer();
+    fresh->firstElementChild()->setInlineStyleProperty(CSSPropertyAlignSelf, CSSValueFlexStart);
+    layout();
+    EXPECT_EQ(width(fresh->firstElementChild()), width(m_child));
+    EXPECT_EQ(height(fresh->firstElementChild()), height(m_child));
+
+    // Stretching it again doesn't reuse the measurement made without.
+    m_child->setInlineStyleProperty(CSSPropertyAlignSelf, CSSValueStretch);
+    EXPECT_LE(1u, layout().measureCacheMisses);
+    EXPECT_EQ(LayoutUnit(100), width(m_child));
+}
+
+} // namespace
+
+} // namespace blink
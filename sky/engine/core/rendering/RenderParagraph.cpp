@@ -17,6 +17,7 @@
 #include "sky/engine/core/rendering/line/RenderTextInfo.h"
 #include "sky/engine/core/rendering/line/WordMeasurement.h"
 #include "sky/engine/platform/fonts/Character.h"
+#include "sky/engine/platform/fonts/GlyphBuffer.h"
 #include "sky/engine/platform/text/BidiResolver.h"
 #include "sky/engine/wtf/RefCountedLeakCounter.h"
 #include "sky/engine/wtf/StdLibExtras.h"
@@ -643,8 +644,17 @@ static inline void setLogicalWidthForTextRun(RootInlineBox* lineBox, BidiRun* ru
         }
     }
 
-    if (!measuredWidth)
-        measuredWidth = renderer->width(run->m_start, run->m_stop - run->m_start, xPos, run->direction(), lineInfo.isFirstLine(), &fallbackFonts, &glyphOverflow);
+    if (!measuredWidth) {
+        // Keep the glyphs of the run, if they're shaped to measure it, for
+        // the box or its line to paint.
+        InlineTextBox* textBox = toInlineTextBox(run->m_box);
+        OwnPtr<GlyphBuffer> glyphBuffer;
+        if (textBox->canUseGlyphsFromLayout())
+            glyphBuffer = adoptPtr(new GlyphBuffer);
+        measuredWidth = renderer->width(run->m_start, run->m_stop - run->m_start, xPos, run->direction(), lineInfo.isFirstLine(), &fallbackFonts, &glyphOverflow, glyphBuffer.get());
+        if (glyphBuffer && !glyphBuffer->isEmpty())
+            textBox->setGlyphsFromLayout(glyphBuffer.release());
+    }
 
     run->m_box->setLogicalWidth(measuredWidth + hyphenWidth);
     if (!fallbackFonts.isEmpty()) {
@@ -573,7 +573,7 @@ LayoutRect RenderText::localCaretRect(InlineBox* inlineBox, int caretOffset, Lay
     return IntRect(left, top, caretWidth, height);
 }
 
-ALWAYS_INLINE float RenderText::widthFromCache(const Font& f, int start, int len, float xPos, TextDirection textDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow) const
+ALWAYS_INLINE float RenderText::widthFromCache(const Font& f, int start, int len, float xPos, TextDirection textDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow, GlyphBuffer* glyphBuffer) const
 {
     if (f.isFixedPitch() && f.fontDescription().variant() == FontVariantNormal && m_isAllASCII && (!glyphOverflow || !glyphOverflow->computeBounds)) {
         float monospaceCharacterWidth = f.spaceWidth();
@@ -615,7 +615,7 @@ ALWAYS_INLINE float RenderText::widthFromCache(const Font& f, int start, int len
     run.setTabSize(!style()->collapseWhiteSpace(), style()->tabSize());
     run.setXPos(xPos);
     FontCachePurgePreventer fontCachePurgePreventer;
-    return f.width(run, fallbackFonts, glyphOverflow);
+    return f.width(run, fallbackFonts, glyphOverflow, glyphBuffer);
 }
 
 void RenderText::trimmedPrefWidths(float leadWidth,
@@ -1255,7 +1255,7 @@ void RenderText::positionLineBox(InlineBox* box)
     m_containsReversedText |= !s->isLeftToRightDirection();
 }
 
-float RenderText::width(unsigned from, unsigned len, float xPos, TextDirection textDirection, bool firstLine, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow) const
+float RenderText::width(unsigned from, unsigned len, float xPos, TextDirection textDirection, bool firstLine, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow, GlyphBuffer* glyphBuffer) const
 {
     if (from >= textLength())
         return 0;
@@ -1263,10 +1263,10 @@ float RenderText::width(unsigned from, unsigned len, float xPos, TextDirection t
     if (from + len > textLength())
         len = textLength() - from;
 
-    return width(from, len, style(firstLine)->font(), xPos, textDirection, fallbackFonts, glyphOverflow);
+    return width(from, len, style(firstLine)->font(), xPos, textDirection, fallbackFonts, glyphOverflow, glyphBuffer);
 }
 
-float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos, TextDirection textDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow) const
+float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos, TextDirection textDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow, GlyphBuffer* glyphBuffer) const
 {
     ASSERT(from + len <= textLength());
     if (!textLength())
@@ -1289,7 +1289,7 @@ float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos,
                 w = maxLogicalWidth();
             }
         } else {
-            w = widthFromCache(f, from, len, xPos, textDirection, fallbackFonts, glyphOverflow);
+            w = widthFromCache(f, from, len, xPos, textDirection, fallbackFonts, glyphOverflow, glyphBuffer);
         }
     } else {
         TextRun run = constructTextRun(const_cast<RenderText*>(this), f, this, from, len, style(), textDirection);
@@ -1299,7 +1299,7 @@ float RenderText::width(unsigned from, unsigned len, const Font& f, float xPos,
         run.setCharacterScanForCodePath(!canUseSimpleFontCodePath());
         run.setTabSize(!style()->collapseWhiteSpace(), style()->tabSize());
         run.setXPos(xPos);
-        w = f.width(run, fallbackFonts, glyphOverflow);
+        w = f.width(run, fallbackFonts, glyphOverflow, glyphBuffer);
     }
 
     return w;
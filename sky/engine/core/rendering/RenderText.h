@@ -32,6 +32,7 @@
 
 namespace blink {
 
+class GlyphBuffer;
 class InlineTextBox;
 
 class RenderText : public RenderObject {
@@ -80,8 +81,9 @@ public:
     unsigned textLength() const { return m_text.length(); } // non virtual implementation of length()
     void positionLineBox(InlineBox*);
 
-    virtual float width(unsigned from, unsigned len, const Font&, float xPos, TextDirection, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
-    virtual float width(unsigned from, unsigned len, float xPos, TextDirection, bool firstLine = false, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
+    // |glyphBuffer| is passed to Font::width(), unless the width is already known.
+    virtual float width(unsigned from, unsigned len, const Font&, float xPos, TextDirection, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0, GlyphBuffer* = 0) const;
+    virtual float width(unsigned from, unsigned len, float xPos, TextDirection, bool firstLine = false, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0, GlyphBuffer* = 0) const;
 
     float minLogicalWidth() const;
     float maxLogicalWidth() const;
@@ -160,7 +162,7 @@ private:
 
     void deleteTextBoxes();
     bool containsOnlyWhitespace(unsigned from, unsigned len) const;
-    float widthFromCache(const Font&, int start, int len, float xPos, TextDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow*) const;
+    float widthFromCache(const Font&, int start, int len, float xPos, TextDirection, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow*, GlyphBuffer* = 0) const;
     bool isAllASCII() const { return m_isAllASCII; }
 
     bool isText() const = delete; // This will catch anyone doing an unnecessary check.
@@ -32,9 +32,14 @@
 #include "sky/engine/platform/geometry/FloatQuad.h"
 #include "sky/engine/platform/geometry/TransformState.h"
 #include "sky/engine/platform/graphics/GraphicsContext.h"
+#include "sky/engine/wtf/TemporaryChange.h"
 
 namespace blink {
 
+// Below this many self-painting layers, visiting each layer is about as fast
+// as querying the index.
+static const size_t minimumLayersForHitTestIndex = 32;
+
 RenderView::RenderView(Document* document)
     : RenderFlexibleBox(document)
     , m_frameView(document->view())
@@ -44,6 +49,8 @@ RenderView::RenderView(Document* document)
     , m_selectionEndPos(-1)
     , m_renderCounterCount(0)
     , m_hitTestCount(0)
+    , m_hitTestIndexIsValid(false)
+    , m_hitTestCandidates(0)
 {
     // init RenderObject attributes
     setInline(false);
@@ -89,6 +96,10 @@ bool RenderView::hitTest(const HitTestRequest& request, const HitTestLocation& l
     if (!request.ignoreClipping())
         hitTestArea.intersect(frame()->view()->visibleContentRect());
 
+    HashSet<RenderBox*> candidates;
+    bool useCandidates = collectHitTestCandidates(location, candidates);
+    TemporaryChange<const HashSet<RenderBox*>*> changeCandidates(m_hitTestCandidates, useCandidates ? &candidates : 0);
+
     bool insideLayer = hitTestLayer(layer(), 0, request, result, hitTestArea, location);
     if (!insideLayer) {
         // TODO(ojan): Is this code needed for Sky?
@@ -104,6 +115,52 @@ bool RenderView::hitTest(const HitTestRequest& request, const HitTestLocation& l
     return insideLayer;
 }
 
+void RenderView::updateHitTestIndex()
+{
+    if (m_hitTestIndexIsValid)
+        return;
+    TRACE_EVENT0("blink", "RenderView::updateHitTestIndex");
+    m_hitTestIndexIsValid = true;
+    m_hitTestIndex.clear();
+    m_hitTestIndexBoxes.clear();
+
+    for (RenderObject* renderer = firstChild(); renderer; renderer = renderer->nextInPreOrder(this)) {
+        if (renderer->isBox() && toRenderBox(renderer)->hasSelfPaintingLayer())
+            m_hitTestIndexBoxes.append(toRenderBox(renderer));
+    }
+
+    // Mapping the bounds is the expensive part, so skip it when there are too
+    // few layers for the index to be used.
+    if (m_hitTestIndexBoxes.size() < minimumLayersForHitTestIndex)
+        return;
+
+    for (RenderBox* box : m_hitTestIndexBoxes) {
+        // Hit testing a layer only finds things inside its visual overflow,
+        // except for descendant layers, which have their own entries.
+        FloatQuad bounds = box->localToAbsoluteQuad(FloatRect(box->visualOverflowRect()), UseTransforms);
+        m_hitTestIndex.add(bounds.boundingBox());
+    }
+}
+
+// Returns false if every layer should be hit tested.
+bool RenderView::collectHitTestCandidates(const HitTestLocation& location, HashSet<RenderBox*>& candidates)
+{
+    updateHitTestIndex();
+    if (m_hitTestIndexBoxes.size() < minimumLayersForHitTestIndex)
+        return false;
+
+    Vector<size_t> hits;
+    m_hitTestIndex.query(location.boundingBox(), hits);
+    for (size_t hit : hits) {
+        // Layers are only reached through the layers that contain them.
+        for (RenderObject* renderer = m_hitTestIndexBoxes[hit]; renderer && renderer != this; renderer = renderer->parent()) {
+            if (renderer->isBox() && !candidates.add(toRenderBox(renderer)).isNewEntry)
+                break;
+        }
+    }
+    return true;
+}
+
 void RenderView::computeLogicalHeight(LayoutUnit logicalHeight, LayoutUnit, LogicalExtentComputedValues& computedValues) const
 {
     computedValues.m_extent = m_frameView ? LayoutUnit(viewLogicalHeight()) : logicalHeight;
@@ -24,6 +24,8 @@
 
 #include "sky/engine/core/frame/FrameView.h"
 #include "sky/engine/core/rendering/RenderFlexibleBox.h"
+#include "sky/engine/platform/geometry/RectIndex.h"
+#include "sky/engine/wtf/HashSet.h"
 #include "sky/engine/wtf/OwnPtr.h"
 
 namespace blink {
@@ -43,6 +45,15 @@ public:
     // Returns the total count of calls to HitTest, for testing.
     unsigned hitTestCount() const { return m_hitTestCount; }
 
+    // Hit tests use an index of the bounds of the self-painting layers to
+    // skip layers that can't contain the hit. The index is rebuilt by the
+    // first hit test after it's invalidated, which layout does, as does any
+    // change to a layer or its transform.
+    void invalidateHitTestIndex() { m_hitTestIndexIsValid = false; }
+    // During a hit test, whether a layer could contain the hit, or contains a
+    // layer that could.
+    bool mayContainHitTestTarget(RenderBox* box) const { return !m_hitTestCandidates || m_hitTestCandidates->contains(box); }
+
     virtual const char* renderName() const override { return "RenderView"; }
 
     virtual bool isRenderView() const override { return true; }
@@ -91,6 +102,9 @@ private:
     virtual const RenderObject* pushMappingToContainer(const RenderBox* ancestorToStopAt, RenderGeometryMap&) const override;
     virtual void mapAbsoluteToLocalPoint(MapCoordinatesFlags, TransformState&) const override;
 
+    void updateHitTestIndex();
+    bool collectHitTestCandidates(const HitTestLocation&, HashSet<RenderBox*>& candidates);
+
     void positionDialog(RenderBox*);
     void positionDialogs();
 
@@ -105,6 +119,14 @@ private:
     unsigned m_renderCounterCount;
 
     unsigned m_hitTestCount;
+
+    // The absolute bounds of m_hitTestIndexBoxes, which are the boxes with
+    // self-painting layers, in the same order. Left empty when there are too
+    // few boxes for hit tests to use it.
+    RectIndex m_hitTestIndex;
+    Vector<RenderBox*> m_hitTestIndexBoxes;
+    bool m_hitTestIndexIsValid;
+    const HashSet<RenderBox*>* m_hitTestCandidates;
 };
 
 DEFINE_RENDER_OBJECT_TYPE_CASTS(RenderView, isRenderView());
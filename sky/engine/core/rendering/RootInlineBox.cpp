@@ -19,6 +19,7 @@
 
 #include "sky/engine/core/rendering/RootInlineBox.h"
 
+#include "gen/sky/platform/RuntimeEnabledFeatures.h"
 #include "sky/engine/core/dom/Document.h"
 #include "sky/engine/core/dom/StyleEngine.h"
 #include "sky/engine/core/rendering/EllipsisBox.h"
@@ -29,6 +30,8 @@
 #include "sky/engine/core/rendering/RenderInline.h"
 #include "sky/engine/core/rendering/RenderView.h"
 #include "sky/engine/core/rendering/VerticalPositionCache.h"
+#include "sky/engine/platform/graphics/GraphicsContext.h"
+#include "sky/engine/platform/graphics/GraphicsContextStateSaver.h"
 #include "sky/engine/platform/text/BidiResolver.h"
 #include "sky/engine/wtf/unicode/Unicode.h"
 
@@ -38,10 +41,24 @@ struct SameSizeAsRootInlineBox : public InlineFlowBox {
     unsigned unsignedVariable;
     void* pointers[2];
     LayoutUnit layoutVariables[5];
+    void* textBatches;
 };
 
 COMPILE_ASSERT(sizeof(RootInlineBox) == sizeof(SameSizeAsRootInlineBox), RootInlineBox_should_stay_small);
 
+// The text boxes of a line in paint order, with a blob for each run of them
+// that share a fill color.
+struct RootInlineBox::TextBatches {
+    struct Batch {
+        Color fillColor;
+        TextBlobPtr textBlob;
+    };
+
+    Vector<InlineTextBox*> boxes;
+    Vector<Color> fillColors;
+    Vector<Batch> batches;
+};
+
 typedef WTF::HashMap<const RootInlineBox*, EllipsisBox*> EllipsisBoxMap;
 static EllipsisBoxMap* gEllipsisBoxMap = 0;
 
@@ -57,6 +74,10 @@ RootInlineBox::RootInlineBox(RenderParagraph& block)
 {
 }
 
+RootInlineBox::~RootInlineBox()
+{
+}
+
 
 void RootInlineBox::destroy()
 {
@@ -154,9 +175,102 @@ void RootInlineBox::paintEllipsisBox(PaintInfo& paintInfo, const LayoutPoint& pa
         ellipsisBox()->paint(paintInfo, paintOffset, lineTop, lineBottom, layers);
 }
 
+typedef Vector<InlineTextBox*, 32> TextBoxVector;
+typedef Vector<Color, 32> TextColorVector;
+
+// Appends the text boxes under |flowBox| in the order InlineFlowBox::paint()
+// paints them. Returns false if anything under it paints more than text.
+static bool collectTextBoxesToBatch(InlineFlowBox* flowBox, TextBoxVector& boxes, TextColorVector& fillColors)
+{
+    for (InlineBox* curr = flowBox->firstChild(); curr; curr = curr->nextOnLine()) {
+        if (curr->isInlineTextBox()) {
+            InlineTextBox* textBox = toInlineTextBox(curr);
+            if (textBox->isLineBreak() || !textBox->len())
+                continue;
+            Color fillColor;
+            if (!textBox->paintsOnlyText(fillColor))
+                return false;
+            boxes.append(textBox);
+            fillColors.append(fillColor);
+        } else if (curr->isInlineFlowBox()) {
+            InlineFlowBox* childFlowBox = toInlineFlowBox(curr);
+            if (childFlowBox->renderer().hasBoxDecorationBackground() || !collectTextBoxesToBatch(childFlowBox, boxes, fillColors))
+                return false;
+        } else if (!curr->renderer().isBox() || !toRenderBox(curr->renderer()).hasSelfPaintingLayer()) {
+            // Boxes with self-painting layers are painted by their layers.
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RootInlineBox::paintTextInBatches(PaintInfo& paintInfo, const LayoutPoint& paintOffset)
+{
+    GraphicsContext* context = paintInfo.context;
+    if (!RuntimeEnabledFeatures::textBlobEnabled() || context->textDrawingMode() != TextModeFill)
+        return false;
+
+    // See paintBoxDecorationBackground().
+    if (isFirstLineStyle() && renderer().style(true) != renderer().style())
+        return false;
+
+    TextBoxVector boxes;
+    TextColorVector fillColors;
+    if (!collectTextBoxesToBatch(this, boxes, fillColors)) {
+        m_textBatches.clear();
+        return false;
+    }
+
+    if (!m_textBatches || m_textBatches->boxes != boxes || m_textBatches->fillColors != fillColors) {
+        OwnPtr<TextBatches> textBatches = adoptPtr(new TextBatches);
+        textBatches->boxes = boxes;
+        textBatches->fillColors = fillColors;
+        for (size_t begin = 0; begin < boxes.size();) {
+            size_t end = begin + 1;
+            while (end < boxes.size() && fillColors[end] == fillColors[begin])
+                ++end;
+
+            SkTextBlobBuilder builder;
+            for (size_t i = begin; i < end; ++i) {
+                if (!boxes[i]->appendTextToBlob(builder)) {
+                    m_textBatches.clear();
+                    return false;
+                }
+            }
+            TextBatches::Batch batch;
+            batch.fillColor = fillColors[begin];
+            batch.textBlob = adoptRef(builder.build());
+            textBatches->batches.append(batch);
+            begin = end;
+        }
+        m_textBatches = textBatches.release();
+    }
+
+    // Matches the origin InlineTextBox::paint() gives each box, relative to
+    // which appendTextToBlob() placed its glyphs.
+    LayoutPoint adjustedPaintOffset = RuntimeEnabledFeatures::subpixelFontScalingEnabled()
+        ? LayoutPoint(paintOffset.x(), paintOffset.y().round())
+        : roundedIntPoint(paintOffset);
+    FloatPoint origin = locationIncludingFlipping();
+    origin.move(adjustedPaintOffset.x().toFloat(), adjustedPaintOffset.y().toFloat());
+
+    GraphicsContextStateSaver stateSaver(*context);
+    for (const TextBatches::Batch& batch : m_textBatches->batches) {
+        if (!batch.textBlob)
+            continue;
+        if (batch.fillColor != context->fillColor())
+            context->setFillColor(batch.fillColor);
+        context->drawTextBlob(batch.textBlob.get(), origin.data(), context->fillPaint());
+    }
+    return true;
+}
+
 void RootInlineBox::paint(PaintInfo& paintInfo, const LayoutPoint& paintOffset, LayoutUnit lineTop, LayoutUnit lineBottom, Vector<RenderBox*>& layers)
 {
-    InlineFlowBox::paint(paintInfo, paintOffset, lineTop, lineBottom, layers);
+    LayoutRect overflowRect(visualOverflowRect(lineTop, lineBottom));
+    overflowRect.moveBy(paintOffset);
+    if (paintInfo.rect.intersects(pixelSnappedIntRect(overflowRect)) && !paintTextInBatches(paintInfo, paintOffset))
+        InlineFlowBox::paint(paintInfo, paintOffset, lineTop, lineBottom, layers);
     paintEllipsisBox(paintInfo, paintOffset, lineTop, lineBottom, layers);
 }
 
@@ -186,6 +300,8 @@ void RootInlineBox::adjustPosition(float dx, float dy)
 
 void RootInlineBox::childRemoved(InlineBox* box)
 {
+    m_textBatches.clear();
+
     if (&box->renderer() == m_lineBreakObj)
         setLineBreakInfo(0, 0, BidiStatus());
 
@@ -201,6 +317,9 @@ LayoutUnit RootInlineBox::alignBoxesInBlockDirection(LayoutUnit heightOfBlock, G
     if (isSVGRootInlineBox())
         return 0;
 
+    // The boxes are about to move relative to the line.
+    m_textBatches.clear();
+
     LayoutUnit maxPositionTop = 0;
     LayoutUnit maxPositionBottom = 0;
     int maxAscent = 0;
@@ -23,6 +23,7 @@
 
 #include "sky/engine/core/rendering/InlineFlowBox.h"
 #include "sky/engine/platform/text/BidiContext.h"
+#include "sky/engine/wtf/OwnPtr.h"
 
 namespace blink {
 
@@ -36,6 +37,7 @@ struct GapRects;
 class RootInlineBox : public InlineFlowBox {
 public:
     explicit RootInlineBox(RenderParagraph&);
+    virtual ~RootInlineBox();
 
     virtual void destroy() override final;
 
@@ -167,8 +169,15 @@ public:
     virtual const char* boxName() const override;
 #endif
 private:
+    struct TextBatches;
+
     LayoutUnit beforeAnnotationsAdjustment() const;
 
+    // Draws the line's text with one blob for each run of boxes that share a
+    // fill color. Returns false, without painting anything, if the line has
+    // anything but text to paint.
+    bool paintTextInBatches(PaintInfo&, const LayoutPoint&);
+
     // This folds into the padding at the end of InlineFlowBox on 64-bit.
     unsigned m_lineBreakPos;
 
@@ -182,6 +191,10 @@ private:
     LayoutUnit m_lineTopWithLeading;
     LayoutUnit m_lineBottomWithLeading;
     LayoutUnit m_selectionBottom;
+
+    // The blobs paintTextInBatches() last drew, kept while the line's boxes
+    // and their colors stay the same.
+    OwnPtr<TextBatches> m_textBatches;
 };
 
 } // namespace blink
@@ -0,0 +1,107 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/rendering/RootInlineBox.h"
+
+#include "core/testing/DummyPageHolder.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/dom/Text.h"
+#include "sky/engine/core/frame/FrameView.h"
+#include "sky/engine/platform/graphics/GraphicsContext.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+// Counts the text draws that reach the canvas without drawing anything.
+class TextDrawCountingCanvas : public SkCanvas {
+public:
+    TextDrawCountingCanvas(int width, int height)
+        : SkCanvas(width, height)
+        , m_textBlobDraws(0)
+        , m_textDraws(0)
+    {
+    }
+
+    int textBlobDraws() const { return m_textBlobDraws; }
+    int textDraws() const { return m_textDraws; }
+
+protected:
+    virtual void onDrawText(const void*, size_t, SkScalar, SkScalar, const SkPaint&) override { ++m_textDraws; }
+    virtual void onDrawPosText(const void*, size_t, const SkPoint[], const SkPaint&) override { ++m_textDraws; }
+    virtual void onDrawPosTextH(const void*, size_t, const SkScalar[], SkScalar, const SkPaint&) override { ++m_textDraws; }
+    virtual void onDrawTextBlob(const SkTextBlob*, SkScalar, SkScalar, const SkPaint&) override { ++m_textBlobDraws; }
+
+private:
+    int m_textBlobDraws;
+    int m_textDraws;
+};
+
+class RootInlineBoxTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_pageHolder = DummyPageHolder::create(IntSize(800, 600));
+        RefPtr<Element> paragraph = document().createElement("p", nullAtom, ASSERT_NO_EXCEPTION);
+        m_span = document().createElement("t", nullAtom, ASSERT_NO_EXCEPTION);
+        m_span->appendChild(document().createText("two "), ASSERT_NO_EXCEPTION);
+        paragraph->appendChild(document().createText("one "), ASSERT_NO_EXCEPTION);
+        paragraph->appendChild(m_span, ASSERT_NO_EXCEPTION);
+        paragraph->appendChild(document().createText("three"), ASSERT_NO_EXCEPTION);
+        document().appendChild(paragraph, ASSERT_NO_EXCEPTION);
+    }
+
+    Document& document() { return m_pageHolder->document(); }
+
+    void paint(TextDrawCountingCanvas& canvas)
+    {
+        document().updateLayout();
+        GraphicsContext context(&canvas);
+        m_pageHolder->frameView().paint(&context, IntRect(0, 0, 800, 600));
+    }
+
+    OwnPtr<DummyPageHolder> m_pageHolder;
+    RefPtr<Element> m_span;
+};
+
+TEST_F(RootInlineBoxTest, LineWithOneColorIsDrawnAsOneBlob)
+{
+    TextDrawCountingCanvas canvas(800, 600);
+    paint(canvas);
+
+    EXPECT_EQ(1, canvas.textBlobDraws());
+    EXPECT_EQ(0, canvas.textDraws());
+}
+
+TEST_F(RootInlineBoxTest, EachColorRunOfALineIsItsOwnBlob)
+{
+    m_span->setInlineStyleProperty(CSSPropertyColor, "red");
+    TextDrawCountingCanvas canvas(800, 600);
+    paint(canvas);
+
+    EXPECT_EQ(3, canvas.textBlobDraws());
+    EXPECT_EQ(0, canvas.textDraws());
+}
+
+TEST_F(RootInlineBoxTest, RepaintReusesTheLineBlobs)
+{
+    TextDrawCountingCanvas firstCanvas(800, 600);
+    paint(firstCanvas);
+
+    // Layout's glyphs were handed to the first paint's blobs; the second
+    // paint draws the same blobs without reshaping.
+    TextDrawCountingCanvas secondCanvas(800, 600);
+    paint(secondCanvas);
+
+    EXPECT_EQ(1, secondCanvas.textBlobDraws());
+    EXPECT_EQ(0, secondCanvas.textDraws());
+}
+
+} // namespace
+
+} // namespace blink
@@ -172,6 +172,7 @@ void RenderStyle::copyNonInheritedFrom(const RenderStyle* other)
     noninherited_flags.position = other->noninherited_flags.position;
     noninherited_flags.unicodeBidi = other->noninherited_flags.unicodeBidi;
     noninherited_flags.explicitInheritance = other->noninherited_flags.explicitInheritance;
+    noninherited_flags.declaresInheritedProperties = other->noninherited_flags.declaresInheritedProperties;
     noninherited_flags.currentColor = other->noninherited_flags.currentColor;
     noninherited_flags.hasViewportUnits = other->noninherited_flags.hasViewportUnits;
 }
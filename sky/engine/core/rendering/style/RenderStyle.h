@@ -164,6 +164,7 @@ protected:
                 && affectedByActive == other.affectedByActive
                 && unicodeBidi == other.unicodeBidi
                 && explicitInheritance == other.explicitInheritance
+                && declaresInheritedProperties == other.declaresInheritedProperties
                 && currentColor == other.currentColor
                 && unique == other.unique
                 && emptyState == other.emptyState
@@ -202,8 +203,9 @@ protected:
         unsigned affectedByActive : 1;
 
         unsigned isLink : 1;
+        unsigned declaresInheritedProperties : 1; // A matched declaration sets an inherited property
         // If you add more style bits here, you will also need to update RenderStyle::copyNonInheritedFrom()
-        // 63 bits
+        // 64 bits
     } noninherited_flags;
 
 // !END SYNC!
@@ -226,6 +228,7 @@ protected:
         noninherited_flags.position = initialPosition();
         noninherited_flags.unicodeBidi = initialUnicodeBidi();
         noninherited_flags.explicitInheritance = false;
+        noninherited_flags.declaresInheritedProperties = false;
         noninherited_flags.currentColor = false;
         noninherited_flags.unique = false;
         noninherited_flags.emptyState = false;
@@ -949,6 +952,12 @@ public:
     void setHasExplicitlyInheritedProperties() { noninherited_flags.explicitInheritance = true; }
     bool hasExplicitlyInheritedProperties() const { return noninherited_flags.explicitInheritance; }
 
+    // Styles that don't declare any inherited property get all of them from
+    // their parent, so a change to the parent's inherited properties can be
+    // copied in without resolving the style again.
+    void setDeclaresInheritedProperties() { noninherited_flags.declaresInheritedProperties = true; }
+    bool declaresInheritedProperties() const { return noninherited_flags.declaresInheritedProperties; }
+
     void setHasCurrentColor() { noninherited_flags.currentColor = true; }
     bool hasCurrentColor() const { return noninherited_flags.currentColor; }
 
@@ -9,8 +9,8 @@
 
 namespace blink {
 
-DOMDartState::DOMDartState(const String& url)
-    : url_(url) {
+DOMDartState::DOMDartState(const String& url, IdleTaskQueue* idle_task_queue)
+    : url_(url), idle_task_queue_(idle_task_queue) {
 }
 
 DOMDartState::~DOMDartState() {
@@ -24,6 +24,13 @@ DOMDartState* DOMDartState::Current() {
   return static_cast<DOMDartState*>(DartState::Current());
 }
 
+IdleTaskQueue* DOMDartState::CurrentIdleTaskQueue() {
+  if (!Dart_CurrentIsolate())
+    return nullptr;
+  DOMDartState* state = Current();
+  return state ? state->idle_task_queue() : nullptr;
+}
+
 void DOMDartState::DidSetIsolate() {
   Scope dart_scope(this);
   x_handle_.Set(this, ToDart("x"));
@@ -11,20 +11,27 @@
 #include "sky/engine/wtf/RefPtr.h"
 
 namespace blink {
+class IdleTaskQueue;
 class LocalFrame;
 class LocalDOMWindow;
 
 class DOMDartState : public DartState {
  public:
-  explicit DOMDartState(const String& url);
+  // |idle_task_queue| belongs to the SkyView, which outlives this state.
+  DOMDartState(const String& url, IdleTaskQueue* idle_task_queue);
   ~DOMDartState() override;
 
   virtual void DidSetIsolate();
 
   const String& url() const { return url_; }
+  IdleTaskQueue* idle_task_queue() const { return idle_task_queue_; }
 
   static DOMDartState* Current();
 
+  // The idle task queue of the SkyView whose isolate is current, or null if
+  // no isolate is.
+  static IdleTaskQueue* CurrentIdleTaskQueue();
+
   // Cached handles to strings used in Dart/C++ conversions.
   Dart_Handle x_handle() { return x_handle_.value(); }
   Dart_Handle y_handle() { return y_handle_.value(); }
@@ -35,6 +42,7 @@ class DOMDartState : public DartState {
 
  private:
   String url_;
+  IdleTaskQueue* idle_task_queue_;
 
   DartPersistentValue x_handle_;
   DartPersistentValue y_handle_;
@@ -0,0 +1,32 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+#include "base/test/test_suite.h"
+#include "sky/engine/core/Init.h"
+#include "sky/engine/platform/TestingPlatformSupport.h"
+#include "sky/engine/wtf/CryptographicallyRandomNumber.h"
+#include "sky/engine/wtf/MainThread.h"
+#include "sky/engine/wtf/WTF.h"
+
+static void AlwaysZeroNumberSource(unsigned char* buf, size_t len)
+{
+    memset(buf, '\0', len);
+}
+
+int main(int argc, char** argv)
+{
+    WTF::setRandomSource(AlwaysZeroNumberSource);
+    WTF::initialize();
+    WTF::initializeMainThread();
+
+    blink::TestingPlatformSupport::Config platformConfig;
+    blink::TestingPlatformSupport platform(platformConfig);
+
+    blink::CoreInitializer initializer;
+    initializer.init();
+    int result = base::RunUnitTestsUsingBaseTestSuite(argc, argv);
+    blink::CoreInitializer::shutdown();
+    return result;
+}
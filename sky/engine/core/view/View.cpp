@@ -4,15 +4,20 @@
 
 #include "sky/engine/core/view/View.h"
 
+#include "base/bind.h"
+#include "sky/engine/platform/IdleTaskQueue.h"
+
 namespace blink {
 
-PassRefPtr<View> View::create(const base::Closure& scheduleFrameCallback)
+PassRefPtr<View> View::create(const base::Closure& scheduleFrameCallback, IdleTaskQueue* idleTaskQueue)
 {
-    return adoptRef(new View(scheduleFrameCallback));
+    return adoptRef(new View(scheduleFrameCallback, idleTaskQueue));
 }
 
-View::View(const base::Closure& scheduleFrameCallback)
+View::View(const base::Closure& scheduleFrameCallback, IdleTaskQueue* idleTaskQueue)
     : m_scheduleFrameCallback(scheduleFrameCallback)
+    , m_idleTaskQueue(idleTaskQueue)
+    , m_weakFactory(this)
 {
 }
 
@@ -52,6 +57,45 @@ void View::scheduleFrame()
     m_scheduleFrameCallback.Run();
 }
 
+void View::requestIdleCallback(PassOwnPtr<IdleCallback> callback)
+{
+    if (m_idleCallbacks.isEmpty())
+        postIdleTask();
+    m_idleCallbacks.append(callback);
+}
+
+void View::postIdleTask()
+{
+    // The view posts one idle task for all of its callbacks. It doesn't keep
+    // the view alive, so a view dropped with callbacks pending is not run.
+    m_idleTaskQueue->postIdleTask(base::Bind(&View::runIdleCallbacks, m_weakFactory.GetWeakPtr()));
+}
+
+void View::runIdleCallbacks(base::TimeTicks deadline)
+{
+    // A callback may drop the last other reference to this view.
+    RefPtr<View> protect(this);
+
+    // Callbacks requested from inside a callback wait for the next period.
+    Vector<OwnPtr<IdleCallback>> callbacks;
+    callbacks.swap(m_idleCallbacks);
+    for (size_t i = 0; i < callbacks.size(); ++i) {
+        base::TimeTicks now = base::TimeTicks::Now();
+        if (now >= deadline) {
+            // The rest keep their place ahead of the newly requested ones.
+            bool posted = !m_idleCallbacks.isEmpty();
+            for (size_t j = 0; j < m_idleCallbacks.size(); ++j)
+                callbacks.append(m_idleCallbacks[j].release());
+            callbacks.remove(0, i);
+            m_idleCallbacks.swap(callbacks);
+            if (!posted)
+                postIdleTask();
+            return;
+        }
+        callbacks[i]->handleEvent((deadline - now).InMillisecondsF());
+    }
+}
+
 void View::setDisplayMetrics(const SkyDisplayMetrics& metrics)
 {
     m_displayMetrics = metrics;
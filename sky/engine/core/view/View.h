@@ -6,23 +6,29 @@
 #define SKY_ENGINE_CORE_VIEW_VIEW_H_
 
 #include "base/callback.h"
+#include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "sky/engine/core/html/VoidCallback.h"
 #include "sky/engine/core/painting/Picture.h"
 #include "sky/engine/core/view/EventCallback.h"
 #include "sky/engine/core/view/FrameCallback.h"
+#include "sky/engine/core/view/IdleCallback.h"
 #include "sky/engine/public/platform/sky_display_metrics.h"
 #include "sky/engine/tonic/dart_wrappable.h"
 #include "sky/engine/wtf/PassRefPtr.h"
 #include "sky/engine/wtf/RefCounted.h"
+#include "sky/engine/wtf/Vector.h"
 
 namespace blink {
 
+class IdleTaskQueue;
+
 class View : public RefCounted<View>, public DartWrappable {
     DEFINE_WRAPPERTYPEINFO();
 public:
     ~View() override;
-    static PassRefPtr<View> create(const base::Closure& scheduleFrameCallback);
+    // |idleTaskQueue| belongs to the SkyView that owns this view.
+    static PassRefPtr<View> create(const base::Closure& scheduleFrameCallback, IdleTaskQueue* idleTaskQueue);
 
     double devicePixelRatio() const { return m_displayMetrics.device_pixel_ratio; }
 
@@ -44,19 +50,28 @@ public:
     void setFrameCallback(PassOwnPtr<FrameCallback> callback);
     void scheduleFrame();
 
+    void requestIdleCallback(PassOwnPtr<IdleCallback> callback);
+
     void setDisplayMetrics(const SkyDisplayMetrics& metrics);
     void handleInputEvent(PassRefPtr<Event> event);
     void beginFrame(base::TimeTicks frameTime);
 
 private:
-    explicit View(const base::Closure& scheduleFrameCallback);
+    View(const base::Closure& scheduleFrameCallback, IdleTaskQueue* idleTaskQueue);
+
+    void postIdleTask();
+    void runIdleCallbacks(base::TimeTicks deadline);
 
     base::Closure m_scheduleFrameCallback;
+    IdleTaskQueue* m_idleTaskQueue;
     SkyDisplayMetrics m_displayMetrics;
     OwnPtr<EventCallback> m_eventCallback;
     OwnPtr<VoidCallback> m_metricsChangedCallback;
     OwnPtr<FrameCallback> m_frameCallback;
+    Vector<OwnPtr<IdleCallback>> m_idleCallbacks;
     RefPtr<Picture> m_picture;
+
+    base::WeakPtrFactory<View> m_weakFactory;
 };
 
 } // namespace blink
@@ -0,0 +1,42 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/IdleTaskQueue.h"
+
+#include "sky/engine/platform/TraceEvent.h"
+
+namespace blink {
+
+IdleTaskQueue::IdleTaskQueue()
+{
+}
+
+PassOwnPtr<IdleTaskQueue> IdleTaskQueue::create()
+{
+    return adoptPtr(new IdleTaskQueue);
+}
+
+void IdleTaskQueue::postIdleTask(const IdleTask& task)
+{
+    m_tasks.append(task);
+    if (m_tasks.size() == 1 && !m_tasksPostedCallback.is_null())
+        m_tasksPostedCallback.Run();
+}
+
+void IdleTaskQueue::setTasksPostedCallback(const base::Closure& callback)
+{
+    m_tasksPostedCallback = callback;
+}
+
+void IdleTaskQueue::runTasks(base::TimeTicks deadline)
+{
+    TRACE_EVENT1("blink", "IdleTaskQueue::runTasks", "pending", static_cast<int>(m_tasks.size()));
+    size_t count = m_tasks.size();
+    for (size_t i = 0; i < count && base::TimeTicks::Now() < deadline; ++i) {
+        IdleTask task = m_tasks.takeFirst();
+        task.Run(deadline);
+    }
+}
+
+} // namespace blink
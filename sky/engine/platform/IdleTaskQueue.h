@@ -0,0 +1,52 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_IDLETASKQUEUE_H_
+#define SKY_ENGINE_PLATFORM_IDLETASKQUEUE_H_
+
+#include "base/callback.h"
+#include "base/time/time.h"
+#include "sky/engine/platform/PlatformExport.h"
+#include "sky/engine/wtf/Deque.h"
+#include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/PassOwnPtr.h"
+
+namespace blink {
+
+// IdleTaskQueue holds work that can wait until the engine is idle, which is
+// after the animator has finished a frame and before the next one is due.
+// Each task is given the deadline of the idle period it runs in and should
+// return before then. Tasks that don't fit in one idle period run in the next
+// one, in the order they were posted.
+//
+// Each SkyView owns one queue, and its embedder drives it: it is told when a
+// task is posted to an empty queue and calls runTasks() once it has an idle
+// period. Main thread only.
+class PLATFORM_EXPORT IdleTaskQueue {
+    WTF_MAKE_NONCOPYABLE(IdleTaskQueue); WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef base::Callback<void(base::TimeTicks deadline)> IdleTask;
+
+    static PassOwnPtr<IdleTaskQueue> create();
+
+    void postIdleTask(const IdleTask&);
+    bool hasPendingTasks() const { return !m_tasks.isEmpty(); }
+
+    // Run when a task is posted to an empty queue.
+    void setTasksPostedCallback(const base::Closure&);
+
+    // Runs the tasks that were pending when it was called until they run out
+    // or |deadline| passes. Tasks posted meanwhile wait for the next period.
+    void runTasks(base::TimeTicks deadline);
+
+private:
+    IdleTaskQueue();
+
+    Deque<IdleTask> m_tasks;
+    base::Closure m_tasksPostedCallback;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_IDLETASKQUEUE_H_
@@ -0,0 +1,124 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/IdleTaskQueue.h"
+
+#include <gtest/gtest.h>
+#include "base/bind.h"
+#include "sky/engine/wtf/OwnPtr.h"
+#include "sky/engine/wtf/Vector.h"
+
+using namespace blink;
+
+namespace {
+
+base::TimeTicks farDeadline()
+{
+    return base::TimeTicks::Now() + base::TimeDelta::FromSeconds(60);
+}
+
+void recordTask(Vector<int>* ran, int id, base::TimeTicks)
+{
+    ran->append(id);
+}
+
+void postTaskFromTask(IdleTaskQueue* queue, Vector<int>* ran, base::TimeTicks)
+{
+    ran->append(0);
+    queue->postIdleTask(base::Bind(&recordTask, ran, 1));
+}
+
+void countPost(int* posts)
+{
+    ++*posts;
+}
+
+class IdleTaskQueueTest : public ::testing::Test {
+protected:
+    IdleTaskQueueTest()
+        : m_queue(IdleTaskQueue::create())
+    {
+    }
+
+    IdleTaskQueue& queue() { return *m_queue; }
+
+private:
+    OwnPtr<IdleTaskQueue> m_queue;
+};
+
+TEST_F(IdleTaskQueueTest, RunsTasksInOrder)
+{
+    IdleTaskQueue& queue = this->queue();
+    Vector<int> ran;
+    queue.postIdleTask(base::Bind(&recordTask, &ran, 1));
+    queue.postIdleTask(base::Bind(&recordTask, &ran, 2));
+    EXPECT_TRUE(queue.hasPendingTasks());
+
+    queue.runTasks(farDeadline());
+    ASSERT_EQ(2u, ran.size());
+    EXPECT_EQ(1, ran[0]);
+    EXPECT_EQ(2, ran[1]);
+    EXPECT_FALSE(queue.hasPendingTasks());
+}
+
+TEST_F(IdleTaskQueueTest, KeepsTasksPastTheDeadline)
+{
+    IdleTaskQueue& queue = this->queue();
+    Vector<int> ran;
+    queue.postIdleTask(base::Bind(&recordTask, &ran, 1));
+
+    queue.runTasks(base::TimeTicks::Now() - base::TimeDelta::FromMilliseconds(1));
+    EXPECT_TRUE(ran.isEmpty());
+    EXPECT_TRUE(queue.hasPendingTasks());
+
+    queue.runTasks(farDeadline());
+    EXPECT_EQ(1u, ran.size());
+}
+
+TEST_F(IdleTaskQueueTest, TasksPostedWhileRunningWaitForTheNextPeriod)
+{
+    IdleTaskQueue& queue = this->queue();
+    Vector<int> ran;
+    queue.postIdleTask(base::Bind(&postTaskFromTask, &queue, &ran));
+
+    queue.runTasks(farDeadline());
+    EXPECT_EQ(1u, ran.size());
+    EXPECT_TRUE(queue.hasPendingTasks());
+
+    queue.runTasks(farDeadline());
+    EXPECT_EQ(2u, ran.size());
+}
+
+TEST_F(IdleTaskQueueTest, NotifiesWhenTheQueueBecomesNonEmpty)
+{
+    IdleTaskQueue& queue = this->queue();
+    Vector<int> ran;
+    int posts = 0;
+    queue.setTasksPostedCallback(base::Bind(&countPost, &posts));
+
+    queue.postIdleTask(base::Bind(&recordTask, &ran, 1));
+    queue.postIdleTask(base::Bind(&recordTask, &ran, 2));
+    EXPECT_EQ(1, posts);
+
+    queue.runTasks(farDeadline());
+    queue.postIdleTask(base::Bind(&recordTask, &ran, 3));
+    EXPECT_EQ(2, posts);
+}
+
+TEST_F(IdleTaskQueueTest, QueuesAreIndependent)
+{
+    OwnPtr<IdleTaskQueue> other = IdleTaskQueue::create();
+    Vector<int> ran;
+    int posts = 0;
+    other->setTasksPostedCallback(base::Bind(&countPost, &posts));
+
+    queue().postIdleTask(base::Bind(&recordTask, &ran, 1));
+    EXPECT_EQ(0, posts);
+    EXPECT_FALSE(other->hasPendingTasks());
+
+    other->runTasks(farDeadline());
+    EXPECT_TRUE(ran.isEmpty());
+}
+
+} // namespace
@@ -0,0 +1,78 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
+
+#include "sky/engine/platform/TraceEvent.h"
+#include "sky/engine/wtf/StdLibExtras.h"
+
+namespace blink {
+
+PurgeableCacheRegistry::PurgeableCacheRegistry()
+{
+}
+
+PurgeableCacheRegistry& PurgeableCacheRegistry::instance()
+{
+    // Not AtomicallyInitializedStatic: caches such as ImageDecodingStore
+    // register from inside their own atomically initialized statics, and that
+    // lock is not recursive. blink::initialize() creates the registry on the
+    // main thread before any other thread can reach it.
+    DEFINE_STATIC_LOCAL(PurgeableCacheRegistry, registry, ());
+    return registry;
+}
+
+void PurgeableCacheRegistry::add(WebPurgeableCache* cache)
+{
+    MutexLocker lock(m_mutex);
+    ASSERT(m_caches.find(cache) == kNotFound);
+    m_caches.append(cache);
+}
+
+void PurgeableCacheRegistry::remove(WebPurgeableCache* cache)
+{
+    MutexLocker lock(m_mutex);
+    size_t index = m_caches.find(cache);
+    ASSERT(index != kNotFound);
+    m_caches.remove(index);
+}
+
+void PurgeableCacheRegistry::purge(WebMemoryPressureLevel level)
+{
+    TRACE_EVENT1("blink", "PurgeableCacheRegistry::purge", "level", level == WebMemoryPressureLevelCritical ? "critical" : "moderate");
+
+    // The lock is held across the purge calls, which is why caches must not
+    // register or unregister from within WebPurgeableCache::purge().
+    MutexLocker lock(m_mutex);
+    for (size_t i = 0; i < m_caches.size(); ++i)
+        m_caches[i]->purge(level);
+}
+
+size_t PurgeableCacheRegistry::memoryUsageInBytes()
+{
+    MutexLocker lock(m_mutex);
+    size_t total = 0;
+    for (size_t i = 0; i < m_caches.size(); ++i)
+        total += m_caches[i]->memoryUsageInBytes();
+    return total;
+}
+
+void PurgeableCacheRegistry::traceMemoryUsage()
+{
+    bool enabled;
+    TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("blink.memory"), &enabled);
+    if (!enabled)
+        return;
+
+    MutexLocker lock(m_mutex);
+    size_t total = 0;
+    for (size_t i = 0; i < m_caches.size(); ++i) {
+        size_t bytes = m_caches[i]->memoryUsageInBytes();
+        TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("blink.memory"), m_caches[i]->cacheName(), m_caches[i], bytes);
+        total += bytes;
+    }
+    TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("blink.memory"), "PurgeableCacheMemoryUsageBytes", total);
+}
+
+} // namespace blink
@@ -0,0 +1,50 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_PURGEABLECACHEREGISTRY_H_
+#define SKY_ENGINE_PLATFORM_PURGEABLECACHEREGISTRY_H_
+
+#include "sky/engine/platform/PlatformExport.h"
+#include "sky/engine/public/platform/WebMemoryPressureLevel.h"
+#include "sky/engine/public/platform/WebPurgeableCache.h"
+#include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/ThreadingPrimitives.h"
+#include "sky/engine/wtf/Vector.h"
+
+namespace blink {
+
+// PurgeableCacheRegistry is the single place the engine goes to when the
+// system asks it to give memory back. Every cache that holds a meaningful
+// amount of memory registers itself here and reports its size, so that a
+// memory pressure signal can be turned into one call to purge() and the total
+// can be traced once per frame.
+//
+// Caches may register from any thread once the registry exists; it is created
+// during blink::initialize(). purge() and traceMemoryUsage() are called on the
+// main thread.
+class PLATFORM_EXPORT PurgeableCacheRegistry {
+    WTF_MAKE_NONCOPYABLE(PurgeableCacheRegistry); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PurgeableCacheRegistry& instance();
+
+    void add(WebPurgeableCache*);
+    void remove(WebPurgeableCache*);
+
+    void purge(WebMemoryPressureLevel);
+
+    size_t memoryUsageInBytes();
+
+    // Emits a trace counter for each registered cache and for the total.
+    void traceMemoryUsage();
+
+private:
+    PurgeableCacheRegistry();
+
+    Mutex m_mutex;
+    Vector<WebPurgeableCache*> m_caches;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_PURGEABLECACHEREGISTRY_H_
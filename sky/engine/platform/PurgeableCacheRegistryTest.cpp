@@ -0,0 +1,74 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class FakeCache final : public WebPurgeableCache {
+public:
+    explicit FakeCache(size_t bytes)
+        : m_bytes(bytes)
+        , m_moderatePurges(0)
+        , m_criticalPurges(0)
+    {
+        PurgeableCacheRegistry::instance().add(this);
+    }
+
+    ~FakeCache()
+    {
+        PurgeableCacheRegistry::instance().remove(this);
+    }
+
+    const char* cacheName() const override { return "FakeCache"; }
+    size_t memoryUsageInBytes() override { return m_bytes; }
+    void purge(WebMemoryPressureLevel level) override
+    {
+        if (level == WebMemoryPressureLevelCritical) {
+            ++m_criticalPurges;
+            m_bytes = 0;
+        } else {
+            ++m_moderatePurges;
+            m_bytes /= 2;
+        }
+    }
+
+    size_t m_bytes;
+    int m_moderatePurges;
+    int m_criticalPurges;
+};
+
+TEST(PurgeableCacheRegistryTest, ReportsMemoryUsage)
+{
+    PurgeableCacheRegistry& registry = PurgeableCacheRegistry::instance();
+    size_t baseline = registry.memoryUsageInBytes();
+    {
+        FakeCache a(1000);
+        FakeCache b(24);
+        EXPECT_EQ(baseline + 1024, registry.memoryUsageInBytes());
+    }
+    EXPECT_EQ(baseline, registry.memoryUsageInBytes());
+}
+
+TEST(PurgeableCacheRegistryTest, ForwardsPurgeLevel)
+{
+    PurgeableCacheRegistry& registry = PurgeableCacheRegistry::instance();
+    FakeCache cache(1024);
+
+    registry.purge(WebMemoryPressureLevelModerate);
+    EXPECT_EQ(1, cache.m_moderatePurges);
+    EXPECT_EQ(0, cache.m_criticalPurges);
+    EXPECT_EQ(512u, cache.m_bytes);
+
+    registry.purge(WebMemoryPressureLevelCritical);
+    EXPECT_EQ(1, cache.m_moderatePurges);
+    EXPECT_EQ(1, cache.m_criticalPurges);
+    EXPECT_EQ(0u, cache.m_bytes);
+}
+
+} // namespace
@@ -131,6 +131,17 @@ float Font::buildGlyphBuffer(const TextRunPaintInfo& runInfo, GlyphBuffer& glyph
     return it.runWidthSoFar() - afterWidth;
 }
 
+const GlyphBuffer& Font::glyphsForRun(const TextRunPaintInfo& runInfo, GlyphBuffer& glyphBuffer, float& initialAdvance) const
+{
+    // The whole run starts at its origin, so there's no initial advance.
+    if (runInfo.shapedGlyphs && !runInfo.from && runInfo.to == static_cast<int>(runInfo.run.length())) {
+        initialAdvance = 0;
+        return *runInfo.shapedGlyphs;
+    }
+    initialAdvance = buildGlyphBuffer(runInfo, glyphBuffer);
+    return glyphBuffer;
+}
+
 void Font::drawText(GraphicsContext* context, const TextRunPaintInfo& runInfo,
     const FloatPoint& point) const
 {
@@ -151,8 +162,9 @@ void Font::drawText(GraphicsContext* context, const TextRunPaintInfo& runInfo,
 
     {
         FontCachePurgePreventer preventer;
-        GlyphBuffer glyphBuffer;
-        float initialAdvance = buildGlyphBuffer(runInfo, glyphBuffer);
+        GlyphBuffer shapedGlyphs;
+        float initialAdvance;
+        const GlyphBuffer& glyphBuffer = glyphsForRun(runInfo, shapedGlyphs, initialAdvance);
 
         if (glyphBuffer.isEmpty())
             return;
@@ -222,7 +234,7 @@ static inline void updateGlyphOverflowFromBounds(const IntRectExtent& glyphBound
     glyphOverflow->right = glyphBounds.right();
 }
 
-float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow) const
+float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFonts, GlyphOverflow* glyphOverflow, GlyphBuffer* glyphBuffer) const
 {
     CodePath codePathToUse = codePath(run);
     if (codePathToUse != ComplexPath) {
@@ -247,11 +259,13 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
 
     float result;
     IntRectExtent glyphBounds;
+    if (shouldSkipDrawing())
+        glyphBuffer = 0;
     if (codePathToUse == ComplexPath) {
-        result = floatWidthForComplexText(run, fallbackFonts, &glyphBounds);
+        result = floatWidthForComplexText(run, fallbackFonts, &glyphBounds, glyphBuffer);
     } else {
         ASSERT(!isCacheable);
-        result = floatWidthForSimpleText(run, fallbackFonts, glyphOverflow ? &glyphBounds : 0);
+        result = floatWidthForSimpleText(run, fallbackFonts, glyphOverflow ? &glyphBounds : 0, glyphBuffer);
     }
 
     if (cacheEntry && (!fallbackFonts || fallbackFonts->isEmpty())) {
@@ -753,10 +767,12 @@ void Font::drawEmphasisMarks(GraphicsContext* context, const TextRunPaintInfo& r
     drawGlyphBuffer(context, runInfo, markBuffer, startPoint);
 }
 
-float Font::floatWidthForSimpleText(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFonts, IntRectExtent* glyphBounds) const
+float Font::floatWidthForSimpleText(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFonts, IntRectExtent* glyphBounds, GlyphBuffer* glyphBuffer) const
 {
     WidthIterator it(this, run, fallbackFonts, glyphBounds);
-    it.advance(run.length());
+    it.advance(run.length(), glyphBuffer);
+    if (glyphBuffer && run.rtl())
+        glyphBuffer->reverse();
 
     if (glyphBounds) {
         glyphBounds->setTop(floorf(-it.minGlyphBoundingBoxY()));
@@ -44,6 +44,7 @@
 #endif
 
 class SkTextBlob;
+class SkTextBlobBuilder;
 struct SkPoint;
 
 namespace blink {
@@ -103,8 +104,17 @@ public:
     void drawText(GraphicsContext*, const TextRunPaintInfo&, const FloatPoint&) const;
     float drawUncachedText(GraphicsContext*, const TextRunPaintInfo&, const FloatPoint&, CustomFontNotReadyAction) const;
     void drawEmphasisMarks(GraphicsContext*, const TextRunPaintInfo&, const AtomicString& mark, const FloatPoint&) const;
-
-    float width(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
+    // Adds the glyphs of the run to |builder| as drawText() would draw them at
+    // |origin|, so runs in several fonts can be drawn as one blob. Returns
+    // false, after which |builder| shouldn't be used, if the run can't be
+    // drawn from a blob or shouldn't be drawn yet.
+    bool appendToTextBlob(const TextRunPaintInfo&, const FloatPoint& origin, SkTextBlobBuilder&) const;
+
+    // If |glyphBuffer| is given, it's filled with the glyphs of the whole run
+    // from the same shaping pass, for TextRunPaintInfo::shapedGlyphs. It's
+    // left empty when the run isn't shaped: when its width comes from the
+    // width cache, or while a custom font is still loading.
+    float width(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0, GlyphBuffer* = 0) const;
     float width(const TextRun&, int& charsConsumed, Glyph& glyphId) const;
 
     int offsetForPosition(const TextRun&, float position, bool includePartialGlyphs) const;
@@ -138,18 +148,21 @@ private:
 
     // Returns the initial in-stream advance.
     float buildGlyphBuffer(const TextRunPaintInfo&, GlyphBuffer&, ForTextEmphasisOrNot = NotForTextEmphasis) const;
+    // Returns the run's shaped glyphs if they cover the range to draw, or else
+    // |glyphBuffer| with the range shaped into it.
+    const GlyphBuffer& glyphsForRun(const TextRunPaintInfo&, GlyphBuffer&, float& initialAdvance) const;
     PassTextBlobPtr buildTextBlob(const GlyphBuffer&, float initialAdvance, const FloatRect& bounds) const;
     void drawGlyphs(GraphicsContext*, const SimpleFontData*, const GlyphBuffer&, unsigned from, unsigned numGlyphs, const FloatPoint&, const FloatRect& textRect) const;
     void drawTextBlob(GraphicsContext*, const SkTextBlob*, const SkPoint& origin) const;
     float drawGlyphBuffer(GraphicsContext*, const TextRunPaintInfo&, const GlyphBuffer&, const FloatPoint&) const;
     void drawEmphasisMarks(GraphicsContext*, const TextRunPaintInfo&, const GlyphBuffer&, const AtomicString&, const FloatPoint&) const;
-    float floatWidthForSimpleText(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts = 0, IntRectExtent* glyphBounds = 0) const;
+    float floatWidthForSimpleText(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts = 0, IntRectExtent* glyphBounds = 0, GlyphBuffer* = 0) const;
     int offsetForPositionForSimpleText(const TextRun&, float position, bool includePartialGlyphs) const;
     FloatRect selectionRectForSimpleText(const TextRun&, const FloatPoint&, int h, int from, int to, bool accountForGlyphBounds) const;
 
     bool getEmphasisMarkGlyphData(const AtomicString&, GlyphData&) const;
 
-    float floatWidthForComplexText(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts, IntRectExtent* glyphBounds) const;
+    float floatWidthForComplexText(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts, IntRectExtent* glyphBounds, GlyphBuffer* = 0) const;
     int offsetForPositionForComplexText(const TextRun&, float position, bool includePartialGlyphs) const;
     FloatRect selectionRectForComplexText(const TextRun&, const FloatPoint&, int h, int from, int to) const;
 
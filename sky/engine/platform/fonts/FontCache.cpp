@@ -32,6 +32,7 @@
 #include "gen/sky/platform/FontFamilyNames.h"
 
 #include "gen/sky/platform/RuntimeEnabledFeatures.h"
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
 #include "sky/engine/platform/fonts/AlternateFontFamily.h"
 #include "sky/engine/platform/fonts/FontCacheClient.h"
 #include "sky/engine/platform/fonts/FontCacheKey.h"
@@ -48,14 +49,50 @@
 #include "sky/engine/wtf/Vector.h"
 #include "sky/engine/wtf/text/AtomicStringHash.h"
 #include "sky/engine/wtf/text/StringHash.h"
+#include "third_party/skia/include/core/SkGraphics.h"
 
 using namespace WTF;
 
 namespace blink {
 
+namespace {
+
+// Skia keeps the rasterized masks of recently drawn glyphs, keyed by typeface,
+// size, subpixel offset and glyph, in a process-wide cache that is shared by
+// every thread that rasterizes text and evicts the least recently used strikes
+// once over budget. Skia's default budget is too small to hold the glyphs of a
+// text-heavy frame, so they would be rasterized again every frame.
+const size_t kGlyphCacheLimitInBytes = 8 * 1024 * 1024;
+
+class GlyphCacheMemoryReporter : public WebPurgeableCache {
+public:
+    virtual const char* cacheName() const override { return "GlyphCache"; }
+
+    virtual size_t memoryUsageInBytes() override { return SkGraphics::GetFontCacheUsed(); }
+
+    // Glyphs that are still on screen are rasterized again on the next frame,
+    // so only give them up under critical pressure.
+    virtual void purge(WebMemoryPressureLevel level) override
+    {
+        if (level == WebMemoryPressureLevelCritical)
+            SkGraphics::PurgeFontCache();
+    }
+};
+
+} // namespace
+
 FontCache::FontCache()
     : m_purgePreventCount(0)
 {
+    PurgeableCacheRegistry::instance().add(this);
+
+    SkGraphics::SetFontCacheLimit(kGlyphCacheLimitInBytes);
+    PurgeableCacheRegistry::instance().add(new GlyphCacheMemoryReporter);
+}
+
+FontCache::~FontCache()
+{
+    PurgeableCacheRegistry::instance().remove(this);
 }
 
 typedef HashMap<FontCacheKey, OwnPtr<FontPlatformData>, FontCacheKeyHash, FontCacheKeyTraits> FontPlatformDataCache;
@@ -223,6 +260,25 @@ void FontCache::purge(PurgeSeverity PurgeSeverity)
     purgeFontVerticalDataCache();
 }
 
+size_t FontCache::memoryUsageInBytes()
+{
+    size_t bytes = gFontDataCache ? gFontDataCache->memoryUsageInBytes() : 0;
+    if (gFontPlatformDataCache)
+        bytes += gFontPlatformDataCache->size() * sizeof(FontPlatformData);
+    return bytes;
+}
+
+void FontCache::purge(WebMemoryPressureLevel level)
+{
+    // Font data still referenced by live fonts is never purged. Under critical
+    // pressure drop every inactive font; otherwise only trim to the usual
+    // inactive font budget.
+    if (level == WebMemoryPressureLevelCritical && !m_purgePreventCount)
+        purge(ForcePurge);
+    else
+        purge(PurgeIfNeeded);
+}
+
 static bool invalidateFontCache = false;
 
 HashSet<RawPtr<FontCacheClient> >& fontCacheClients()
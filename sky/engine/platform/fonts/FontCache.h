@@ -33,6 +33,7 @@
 #include <limits.h>
 #include "sky/engine/platform/PlatformExport.h"
 #include "sky/engine/platform/fonts/FontFaceCreationParams.h"
+#include "sky/engine/public/platform/WebPurgeableCache.h"
 #include "sky/engine/wtf/Forward.h"
 #include "sky/engine/wtf/HashMap.h"
 #include "sky/engine/wtf/PassRefPtr.h"
@@ -59,7 +60,7 @@ class SimpleFontData;
 enum ShouldRetain { Retain, DoNotRetain };
 enum PurgeSeverity { PurgeIfNeeded, ForcePurge };
 
-class PLATFORM_EXPORT FontCache {
+class PLATFORM_EXPORT FontCache final : public WebPurgeableCache {
     friend class FontCachePurgePreventer;
 
     WTF_MAKE_NONCOPYABLE(FontCache); WTF_MAKE_FAST_ALLOCATED;
@@ -107,6 +108,11 @@ public:
     static void getFontForCharacter(UChar32, const char* preferredLocale, PlatformFallbackFont*);
 #endif
 
+    // WebPurgeableCache
+    virtual const char* cacheName() const override { return "FontCache"; }
+    virtual size_t memoryUsageInBytes() override;
+    virtual void purge(WebMemoryPressureLevel) override;
+
 private:
     FontCache();
     ~FontCache();
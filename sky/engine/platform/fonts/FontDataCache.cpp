@@ -116,6 +116,11 @@ bool FontDataCache::purge(PurgeSeverity PurgeSeverity)
     return false;
 }
 
+size_t FontDataCache::memoryUsageInBytes() const
+{
+    return m_cache.size() * (sizeof(SimpleFontData) + sizeof(FontPlatformData));
+}
+
 bool FontDataCache::purgeLeastRecentlyUsed(int count)
 {
     static bool isPurging; // Guard against reentry when e.g. a deleted FontData releases its small caps FontData.
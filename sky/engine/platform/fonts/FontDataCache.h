@@ -86,6 +86,10 @@ public:
     // Returns true if any removal of cache items actually occurred.
     bool purge(PurgeSeverity);
 
+    // An estimate of the memory held by cached font data, not counting the
+    // typefaces and glyph caches owned by Skia.
+    size_t memoryUsageInBytes() const;
+
 private:
     bool purgeLeastRecentlyUsed(int count);
 
@@ -28,6 +28,9 @@
 
 #include "sky/engine/platform/fonts/Character.h"
 #include "sky/engine/platform/fonts/Font.h"
+#include "sky/engine/platform/fonts/FontDescription.h"
+#include "sky/engine/platform/fonts/GlyphBuffer.h"
+#include "sky/engine/platform/text/TextRun.h"
 
 #include <gtest/gtest.h>
 
@@ -361,5 +364,42 @@ TEST(FontTest, TestIsCJKIdeographOrSymbol)
     TestSpecificUChar32RangeIdeographSymbol(0x1F200, 0x1F6FF);
 }
 
+static Font createTestFont()
+{
+    FontDescription fontDescription;
+    fontDescription.setGenericFamily(FontDescription::StandardFamily);
+    fontDescription.setSpecifiedSize(16);
+    fontDescription.setComputedSize(16);
+    Font font(fontDescription);
+    font.update(nullptr);
+    return font;
+}
+
+TEST(FontTest, WidthKeepsGlyphsFromItsShapingPass)
+{
+    Font font = createTestFont();
+    TextRun run(String("Layout text"));
+
+    GlyphBuffer glyphBuffer;
+    float width = font.width(run, 0, 0, &glyphBuffer);
+    EXPECT_EQ(font.width(run), width);
+    EXPECT_EQ(run.length(), glyphBuffer.size());
+}
+
+TEST(FontTest, WidthFromCacheLeavesGlyphBufferEmpty)
+{
+    // Only complex path runs are cached.
+    Font::setCodePath(ComplexPath);
+    Font font = createTestFont();
+    TextRun run(String("Cached text"));
+
+    float width = font.width(run);
+    GlyphBuffer glyphBuffer;
+    EXPECT_EQ(width, font.width(run, 0, 0, &glyphBuffer));
+    EXPECT_TRUE(glyphBuffer.isEmpty());
+
+    Font::setCodePath(AutoPath);
+}
+
 } // namespace blink
 
@@ -29,6 +29,7 @@
 #include "sky/engine/platform/fonts/GlyphPageTreeNode.h"
 
 #include <stdio.h>
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
 #include "sky/engine/platform/fonts/SegmentedFontData.h"
 #include "sky/engine/platform/fonts/SimpleFontData.h"
 #include "sky/engine/platform/fonts/opentype/OpenTypeVerticalData.h"
@@ -44,6 +45,22 @@ using std::min;
 HashMap<int, GlyphPageTreeNode*>* GlyphPageTreeNode::roots = 0;
 GlyphPageTreeNode* GlyphPageTreeNode::pageZeroRoot = 0;
 
+namespace {
+
+// Glyph pages are pruned when FontCache releases the font data that owns them,
+// so the tree only reports its size and relies on FontCache to do the purging.
+class GlyphPageTreeMemoryReporter final : public WebPurgeableCache {
+public:
+    virtual const char* cacheName() const override { return "GlyphPageTree"; }
+    virtual size_t memoryUsageInBytes() override
+    {
+        return GlyphPageTreeNode::treeGlyphPageCount() * (sizeof(GlyphPage) + sizeof(SimpleFontData*) * GlyphPage::size);
+    }
+    virtual void purge(WebMemoryPressureLevel) override { }
+};
+
+} // namespace
+
 GlyphPageTreeNode* GlyphPageTreeNode::getRoot(unsigned pageNumber)
 {
     static bool initialized;
@@ -51,6 +68,7 @@ GlyphPageTreeNode* GlyphPageTreeNode::getRoot(unsigned pageNumber)
         initialized = true;
         roots = new HashMap<int, GlyphPageTreeNode*>;
         pageZeroRoot = new GlyphPageTreeNode;
+        PurgeableCacheRegistry::instance().add(new GlyphPageTreeMemoryReporter);
     }
 
     if (!pageNumber)
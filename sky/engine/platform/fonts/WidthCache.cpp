@@ -0,0 +1,76 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/fonts/WidthCache.h"
+
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
+#include "sky/engine/wtf/StdLibExtras.h"
+
+namespace blink {
+
+namespace {
+
+typedef HashSet<WidthCache*> WidthCacheSet;
+
+WidthCacheSet& liveWidthCaches()
+{
+    DEFINE_STATIC_LOCAL(WidthCacheSet, caches, ());
+    return caches;
+}
+
+// WidthCaches are owned by FontFallbackLists, of which there can be many, so
+// they are reported to the registry together rather than one by one.
+class WidthCacheMemoryReporter final : public WebPurgeableCache {
+public:
+    virtual const char* cacheName() const override { return "WidthCache"; }
+
+    virtual size_t memoryUsageInBytes() override
+    {
+        size_t bytes = 0;
+        WidthCacheSet::iterator end = liveWidthCaches().end();
+        for (WidthCacheSet::iterator it = liveWidthCaches().begin(); it != end; ++it)
+            bytes += (*it)->memoryUsageInBytes();
+        return bytes;
+    }
+
+    // Widths are cheap to measure again, so any pressure clears them all.
+    virtual void purge(WebMemoryPressureLevel) override
+    {
+        WidthCacheSet::iterator end = liveWidthCaches().end();
+        for (WidthCacheSet::iterator it = liveWidthCaches().begin(); it != end; ++it)
+            (*it)->clear();
+    }
+};
+
+void ensureMemoryReporter()
+{
+    static bool registered = false;
+    if (registered)
+        return;
+    registered = true;
+    PurgeableCacheRegistry::instance().add(new WidthCacheMemoryReporter);
+}
+
+} // namespace
+
+WidthCache::WidthCache()
+    : m_interval(s_maxInterval)
+    , m_countdown(m_interval)
+{
+    ensureMemoryReporter();
+    liveWidthCaches().add(this);
+}
+
+WidthCache::~WidthCache()
+{
+    liveWidthCaches().remove(this);
+}
+
+size_t WidthCache::memoryUsageInBytes() const
+{
+    return m_singleCharMap.capacity() * sizeof(SingleCharMap::ValueType)
+        + m_map.capacity() * sizeof(Map::ValueType);
+}
+
+} // namespace blink
@@ -32,6 +32,7 @@
 #include "sky/engine/wtf/HashFunctions.h"
 #include "sky/engine/wtf/HashSet.h"
 #include "sky/engine/wtf/HashTableDeletedValueType.h"
+#include "sky/engine/wtf/Noncopyable.h"
 #include "sky/engine/wtf/StringHasher.h"
 
 namespace blink {
@@ -46,7 +47,10 @@ struct WidthCacheEntry {
     IntRectExtent glyphBounds;
 };
 
+// Every live WidthCache is reported to PurgeableCacheRegistry as a single
+// "WidthCache" entry and is cleared on any memory pressure signal.
 class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache);
 private:
     // Used to optimize small strings as hash table keys. Avoids malloc'ing an out-of-line StringImpl.
     class SmallStringKey {
@@ -122,11 +126,8 @@ private:
     friend bool operator==(const SmallStringKey&, const SmallStringKey&);
 
 public:
-    WidthCache()
-        : m_interval(s_maxInterval)
-        , m_countdown(m_interval)
-    {
-    }
+    WidthCache();
+    ~WidthCache();
 
     WidthCacheEntry* add(const TextRun& run, WidthCacheEntry entry)
     {
@@ -147,6 +148,8 @@ public:
         m_map.clear();
     }
 
+    size_t memoryUsageInBytes() const;
+
 private:
     WidthCacheEntry* addSlowCase(const TextRun& run, WidthCacheEntry entry)
     {
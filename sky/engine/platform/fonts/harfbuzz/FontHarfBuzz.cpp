@@ -224,10 +224,10 @@ void Font::drawTextBlob(GraphicsContext* gc, const SkTextBlob* blob, const SkPoi
     }
 }
 
-float Font::floatWidthForComplexText(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFonts, IntRectExtent* glyphBounds) const
+float Font::floatWidthForComplexText(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFonts, IntRectExtent* glyphBounds, GlyphBuffer* glyphBuffer) const
 {
     HarfBuzzShaper shaper(this, run, HarfBuzzShaper::NotForTextEmphasis, fallbackFonts);
-    if (!shaper.shape())
+    if (!shaper.shape(glyphBuffer))
         return 0;
 
     glyphBounds->setTop(floorf(-shaper.glyphBoundingBox().top()));
@@ -262,7 +262,7 @@ FloatRect Font::selectionRectForComplexText(const TextRun& run,
 namespace {
 
 template <bool hasOffsets>
-bool buildTextBlobInternal(const GlyphBuffer& glyphBuffer, SkScalar initialAdvance, SkTextBlobBuilder& builder)
+bool buildTextBlobInternal(const GlyphBuffer& glyphBuffer, SkScalar initialAdvance, SkScalar y, SkTextBlobBuilder& builder)
 {
     SkScalar x = initialAdvance;
     unsigned i = 0;
@@ -291,7 +291,7 @@ bool buildTextBlobInternal(const GlyphBuffer& glyphBuffer, SkScalar initialAdvan
 
         const SkTextBlobBuilder::RunBuffer& buffer = hasOffsets ?
             builder.allocRunPos(paint, count) :
-            builder.allocRunPosH(paint, count, 0);
+            builder.allocRunPosH(paint, count, y);
 
         const uint16_t* glyphs = glyphBuffer.glyphs(start);
         std::copy(glyphs, glyphs + count, buffer.glyphs);
@@ -302,7 +302,7 @@ bool buildTextBlobInternal(const GlyphBuffer& glyphBuffer, SkScalar initialAdvan
             if (hasOffsets) {
                 const FloatSize& offset = offsets[j];
                 buffer.pos[2 * j] = x + offset.width();
-                buffer.pos[2 * j + 1] = offset.height();
+                buffer.pos[2 * j + 1] = y + offset.height();
             } else {
                 buffer.pos[j] = x;
             }
@@ -322,10 +322,30 @@ PassTextBlobPtr Font::buildTextBlob(const GlyphBuffer& glyphBuffer, float initia
     SkScalar advance = SkFloatToScalar(initialAdvance);
 
     bool success = glyphBuffer.hasOffsets() ?
-        buildTextBlobInternal<true>(glyphBuffer, advance, builder) :
-        buildTextBlobInternal<false>(glyphBuffer, advance, builder);
+        buildTextBlobInternal<true>(glyphBuffer, advance, 0, builder) :
+        buildTextBlobInternal<false>(glyphBuffer, advance, 0, builder);
     return success ? adoptRef(builder.build()) : nullptr;
 }
 
+bool Font::appendToTextBlob(const TextRunPaintInfo& runInfo, const FloatPoint& origin, SkTextBlobBuilder& builder) const
+{
+    ASSERT(RuntimeEnabledFeatures::textBlobEnabled());
+    if (shouldSkipDrawing())
+        return false;
+
+    FontCachePurgePreventer preventer;
+    GlyphBuffer shapedGlyphs;
+    float initialAdvance;
+    const GlyphBuffer& glyphBuffer = glyphsForRun(runInfo, shapedGlyphs, initialAdvance);
+    if (glyphBuffer.isEmpty())
+        return true;
+
+    SkScalar x = SkFloatToScalar(origin.x() + initialAdvance);
+    SkScalar y = SkFloatToScalar(origin.y());
+    return glyphBuffer.hasOffsets() ?
+        buildTextBlobInternal<true>(glyphBuffer, x, y, builder) :
+        buildTextBlobInternal<false>(glyphBuffer, x, y, builder);
+}
+
 
 } // namespace blink
@@ -0,0 +1,164 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/geometry/RectIndex.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace blink {
+
+namespace {
+
+// The number of children of each node.
+const size_t kBranchingFactor = 8;
+
+// Unlike FloatRect::intersects, also true for rects that only share an edge
+// and for empty rects, so a point on the edge of a box finds it.
+bool touches(const FloatRect& a, const FloatRect& b)
+{
+    return a.x() <= b.maxX() && b.x() <= a.maxX() && a.y() <= b.maxY() && b.y() <= a.maxY();
+}
+
+// Unlike FloatRect::unite, keeps empty rects.
+FloatRect unionOf(const FloatRect& a, const FloatRect& b)
+{
+    float left = std::min(a.x(), b.x());
+    float top = std::min(a.y(), b.y());
+    float right = std::max(a.maxX(), b.maxX());
+    float bottom = std::max(a.maxY(), b.maxY());
+    return FloatRect(left, top, right - left, bottom - top);
+}
+
+bool lessByCenterX(const FloatRect& a, const FloatRect& b)
+{
+    return a.x() + a.maxX() < b.x() + b.maxX();
+}
+
+bool lessByCenterY(const FloatRect& a, const FloatRect& b)
+{
+    return a.y() + a.maxY() < b.y() + b.maxY();
+}
+
+// Orders |items| so that each run of kBranchingFactor consecutive items is
+// close together: the items are cut into vertical slices by x and each slice
+// is sorted by y.
+template<typename T, typename GetRect>
+void sortTileRecursive(T* begin, T* end, GetRect rect)
+{
+    size_t count = end - begin;
+    size_t parentCount = (count + kBranchingFactor - 1) / kBranchingFactor;
+    size_t sliceCount = ceil(sqrt(static_cast<double>(parentCount)));
+    size_t sliceSize = sliceCount * kBranchingFactor;
+
+    std::sort(begin, end, [&rect](const T& a, const T& b) {
+        return lessByCenterX(rect(a), rect(b));
+    });
+    for (T* slice = begin; slice < end; slice += sliceSize) {
+        T* sliceEnd = std::min(slice + sliceSize, end);
+        std::sort(slice, sliceEnd, [&rect](const T& a, const T& b) {
+            return lessByCenterY(rect(a), rect(b));
+        });
+    }
+}
+
+} // namespace
+
+RectIndex::RectIndex()
+    : m_leafCount(0)
+    , m_isBuilt(false)
+{
+}
+
+RectIndex::~RectIndex()
+{
+}
+
+size_t RectIndex::add(const FloatRect& rect)
+{
+    Entry entry;
+    entry.rect = rect;
+    entry.index = m_entries.size();
+    m_entries.append(entry);
+    m_isBuilt = false;
+    return entry.index;
+}
+
+void RectIndex::clear()
+{
+    m_entries.clear();
+    m_nodes.clear();
+    m_leafCount = 0;
+    m_isBuilt = false;
+}
+
+void RectIndex::build()
+{
+    m_nodes.clear();
+    m_isBuilt = true;
+    if (m_entries.isEmpty())
+        return;
+
+    sortTileRecursive(m_entries.begin(), m_entries.end(), [](const Entry& entry) -> const FloatRect& {
+        return entry.rect;
+    });
+    for (size_t begin = 0; begin < m_entries.size(); begin += kBranchingFactor) {
+        Node node;
+        node.begin = begin;
+        node.end = std::min(begin + kBranchingFactor, m_entries.size());
+        node.bounds = m_entries[begin].rect;
+        for (size_t i = begin + 1; i < node.end; ++i)
+            node.bounds = unionOf(node.bounds, m_entries[i].rect);
+        m_nodes.append(node);
+    }
+    m_leafCount = m_nodes.size();
+
+    size_t levelBegin = 0;
+    while (m_nodes.size() - levelBegin > 1) {
+        size_t levelEnd = m_nodes.size();
+        // The parents of the level below don't exist yet, so its nodes can
+        // still be reordered.
+        sortTileRecursive(m_nodes.begin() + levelBegin, m_nodes.begin() + levelEnd, [](const Node& node) -> const FloatRect& {
+            return node.bounds;
+        });
+        for (size_t begin = levelBegin; begin < levelEnd; begin += kBranchingFactor) {
+            Node node;
+            node.begin = begin;
+            node.end = std::min(begin + kBranchingFactor, levelEnd);
+            node.bounds = m_nodes[begin].bounds;
+            for (size_t i = begin + 1; i < node.end; ++i)
+                node.bounds = unionOf(node.bounds, m_nodes[i].bounds);
+            m_nodes.append(node);
+        }
+        levelBegin = levelEnd;
+    }
+}
+
+void RectIndex::query(const FloatRect& rect, Vector<size_t>& results)
+{
+    if (!m_isBuilt)
+        build();
+    if (m_nodes.isEmpty())
+        return;
+
+    size_t firstResult = results.size();
+    Vector<size_t, 32> stack;
+    stack.append(m_nodes.size() - 1);
+    while (!stack.isEmpty()) {
+        const Node& node = m_nodes[stack.last()];
+        bool isLeaf = stack.last() < m_leafCount;
+        stack.removeLast();
+        if (!touches(node.bounds, rect))
+            continue;
+        for (size_t i = node.begin; i < node.end; ++i) {
+            if (!isLeaf)
+                stack.append(i);
+            else if (touches(m_entries[i].rect, rect))
+                results.append(m_entries[i].index);
+        }
+    }
+    std::sort(results.begin() + firstResult, results.end());
+}
+
+} // namespace blink
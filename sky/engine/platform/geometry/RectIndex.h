@@ -0,0 +1,66 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_GEOMETRY_RECTINDEX_H_
+#define SKY_ENGINE_PLATFORM_GEOMETRY_RECTINDEX_H_
+
+#include "sky/engine/platform/PlatformExport.h"
+#include "sky/engine/platform/geometry/FloatRect.h"
+#include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/Vector.h"
+
+namespace blink {
+
+// RectIndex finds the rects that intersect a query rect or point in
+// logarithmic time. It is an R-tree that is packed all at once with the
+// Sort-Tile-Recursive algorithm, which suits sets of rects that are built in
+// one go, like the boxes of a frame, and then queried many times.
+//
+// Rects are identified by the order they were added in. Adding a rect after
+// the tree is packed makes the next query pack it again.
+class PLATFORM_EXPORT RectIndex {
+    WTF_MAKE_NONCOPYABLE(RectIndex); WTF_MAKE_FAST_ALLOCATED;
+public:
+    RectIndex();
+    ~RectIndex();
+
+    // Returns the index of the rect.
+    size_t add(const FloatRect&);
+    void clear();
+
+    size_t size() const { return m_entries.size(); }
+    bool isEmpty() const { return m_entries.isEmpty(); }
+
+    // Appends the indices of the rects that intersect or touch |rect| to
+    // |results|, in the order the rects were added.
+    void query(const FloatRect&, Vector<size_t>& results);
+    void query(const FloatPoint& point, Vector<size_t>& results) { query(FloatRect(point, FloatSize()), results); }
+
+private:
+    struct Entry {
+        FloatRect rect;
+        size_t index;
+    };
+
+    struct Node {
+        FloatRect bounds;
+        // The children are m_entries[begin, end) for leaves and
+        // m_nodes[begin, end) otherwise.
+        unsigned begin;
+        unsigned end;
+    };
+
+    void build();
+
+    Vector<Entry> m_entries;
+    // Each level of the tree is stored after the one below it, so the leaves
+    // come first and the root is last.
+    Vector<Node> m_nodes;
+    size_t m_leafCount;
+    bool m_isBuilt;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_GEOMETRY_RECTINDEX_H_
@@ -0,0 +1,95 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/geometry/RectIndex.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+Vector<size_t> queryPoint(RectIndex& index, float x, float y)
+{
+    Vector<size_t> results;
+    index.query(FloatPoint(x, y), results);
+    return results;
+}
+
+} // namespace
+
+TEST(RectIndexTest, Empty)
+{
+    RectIndex index;
+    EXPECT_TRUE(index.isEmpty());
+    EXPECT_TRUE(queryPoint(index, 0, 0).isEmpty());
+}
+
+TEST(RectIndexTest, FindsOverlappingRectsInInsertionOrder)
+{
+    RectIndex index;
+    EXPECT_EQ(0u, index.add(FloatRect(0, 0, 100, 100)));
+    EXPECT_EQ(1u, index.add(FloatRect(50, 50, 10, 10)));
+    EXPECT_EQ(2u, index.add(FloatRect(200, 0, 10, 10)));
+
+    Vector<size_t> results = queryPoint(index, 55, 55);
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(0u, results[0]);
+    EXPECT_EQ(1u, results[1]);
+
+    // Edges are inclusive.
+    results = queryPoint(index, 100, 100);
+    ASSERT_EQ(1u, results.size());
+    EXPECT_EQ(0u, results[0]);
+
+    EXPECT_TRUE(queryPoint(index, 150, 5).isEmpty());
+}
+
+TEST(RectIndexTest, MatchesLinearScanOnGrid)
+{
+    RectIndex index;
+    Vector<FloatRect> rects;
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 40; ++x) {
+            // Rects overlap their neighbours, and some are empty.
+            FloatRect rect(x * 10, y * 10, (x + y) % 7 ? 15 : 0, 12);
+            rects.append(rect);
+            index.add(rect);
+        }
+    }
+
+    FloatRect queries[] = {
+        FloatRect(0, 0, 0, 0),
+        FloatRect(123, 77, 0, 0),
+        FloatRect(205, 310, 40, 25),
+        FloatRect(-10, -10, 5, 5),
+        FloatRect(0, 0, 1000, 1000),
+    };
+    for (const FloatRect& query : queries) {
+        Vector<size_t> expected;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            const FloatRect& rect = rects[i];
+            if (rect.x() <= query.maxX() && query.x() <= rect.maxX() && rect.y() <= query.maxY() && query.y() <= rect.maxY())
+                expected.append(i);
+        }
+        Vector<size_t> results;
+        index.query(query, results);
+        EXPECT_EQ(expected, results);
+    }
+}
+
+TEST(RectIndexTest, AddAfterQueryRebuilds)
+{
+    RectIndex index;
+    index.add(FloatRect(0, 0, 10, 10));
+    EXPECT_EQ(1u, queryPoint(index, 5, 5).size());
+
+    index.add(FloatRect(0, 0, 20, 20));
+    EXPECT_EQ(2u, queryPoint(index, 5, 5).size());
+
+    index.clear();
+    EXPECT_TRUE(queryPoint(index, 5, 5).isEmpty());
+}
+
+} // namespace blink
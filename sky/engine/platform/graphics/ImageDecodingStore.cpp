@@ -25,6 +25,7 @@
 
 #include "sky/engine/platform/graphics/ImageDecodingStore.h"
 
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
 #include "sky/engine/platform/TraceEvent.h"
 #include "sky/engine/wtf/Threading.h"
 
@@ -40,10 +41,12 @@ ImageDecodingStore::ImageDecodingStore()
     : m_heapLimitInBytes(defaultMaxTotalSizeOfHeapEntries)
     , m_heapMemoryUsageInBytes(0)
 {
+    PurgeableCacheRegistry::instance().add(this);
 }
 
 ImageDecodingStore::~ImageDecodingStore()
 {
+    PurgeableCacheRegistry::instance().remove(this);
 #if ENABLE(ASSERT)
     setCacheLimitInBytes(0);
     ASSERT(!m_decoderCacheMap.size());
@@ -140,12 +143,35 @@ void ImageDecodingStore::removeCacheIndexedByGenerator(const ImageFrameGenerator
 }
 
 void ImageDecodingStore::clear()
+{
+    pruneToLimit(0);
+}
+
+void ImageDecodingStore::purge(WebMemoryPressureLevel level)
+{
+    if (level == WebMemoryPressureLevelCritical) {
+        clear();
+        return;
+    }
+
+    // Under moderate pressure give back half of what is cached, starting with
+    // the least recently used decoders.
+    size_t targetInBytes;
+    {
+        MutexLocker lock(m_mutex);
+        targetInBytes = m_heapMemoryUsageInBytes / 2;
+    }
+    if (targetInBytes)
+        pruneToLimit(targetInBytes);
+}
+
+void ImageDecodingStore::pruneToLimit(size_t temporaryLimitInBytes)
 {
     size_t cacheLimitInBytes;
     {
         MutexLocker lock(m_mutex);
         cacheLimitInBytes = m_heapLimitInBytes;
-        m_heapLimitInBytes = 0;
+        m_heapLimitInBytes = std::min(m_heapLimitInBytes, temporaryLimitInBytes);
     }
 
     prune();
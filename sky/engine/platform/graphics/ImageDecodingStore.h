@@ -29,6 +29,7 @@
 #include "platform/image-decoders/ImageDecoder.h"
 #include "sky/engine/platform/graphics/skia/SkSizeHash.h"
 #include "sky/engine/platform/PlatformExport.h"
+#include "sky/engine/public/platform/WebPurgeableCache.h"
 #include "sky/engine/wtf/DoublyLinkedList.h"
 #include "sky/engine/wtf/HashSet.h"
 #include "sky/engine/wtf/OwnPtr.h"
@@ -60,10 +61,10 @@ class ImageFrameGenerator;
 //
 // All public methods can be used on any thread.
 
-class PLATFORM_EXPORT ImageDecodingStore {
+class PLATFORM_EXPORT ImageDecodingStore final : public WebPurgeableCache {
 public:
     static PassOwnPtr<ImageDecodingStore> create() { return adoptPtr(new ImageDecodingStore); }
-    ~ImageDecodingStore();
+    virtual ~ImageDecodingStore();
 
     static ImageDecodingStore* instance();
 
@@ -79,10 +80,14 @@ public:
 
     void clear();
     void setCacheLimitInBytes(size_t);
-    size_t memoryUsageInBytes();
     int cacheEntries();
     int decoderCacheEntries();
 
+    // WebPurgeableCache
+    virtual const char* cacheName() const override { return "ImageDecodingStore"; }
+    virtual size_t memoryUsageInBytes() override;
+    virtual void purge(WebMemoryPressureLevel) override;
+
 private:
     // Decoder cache entry is identified by:
     // 1. Pointer to ImageFrameGenerator.
@@ -165,6 +170,7 @@ private:
     ImageDecodingStore();
 
     void prune();
+    void pruneToLimit(size_t);
 
     // These helper methods are called while m_mutex is locked.
     template<class T, class U, class V> void insertCacheInternal(PassOwnPtr<T> cacheEntry, U* cacheMap, V* identifierMap);
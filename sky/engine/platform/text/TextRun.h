@@ -248,6 +248,7 @@ struct TextRunPaintInfo {
         , from(0)
         , to(r.length())
         , cachedTextBlob(nullptr)
+        , shapedGlyphs(nullptr)
     {
     }
 
@@ -256,6 +257,10 @@ struct TextRunPaintInfo {
     int to;
     FloatRect bounds;
     RefPtr<const SkTextBlob>* cachedTextBlob;
+    // The glyphs of the whole run, if it was already shaped, e.g. by layout.
+    // They're drawn instead of shaping the run again when from and to cover
+    // all of it.
+    const GlyphBuffer* shapedGlyphs;
 };
 
 }
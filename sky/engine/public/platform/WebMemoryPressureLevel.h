@@ -0,0 +1,19 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PUBLIC_PLATFORM_WEBMEMORYPRESSURELEVEL_H_
+#define SKY_ENGINE_PUBLIC_PLATFORM_WEBMEMORYPRESSURELEVEL_H_
+
+namespace blink {
+
+enum WebMemoryPressureLevel {
+    // Release memory that is cheap to recreate.
+    WebMemoryPressureLevelModerate,
+    // Release as much memory as possible.
+    WebMemoryPressureLevelCritical
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PUBLIC_PLATFORM_WEBMEMORYPRESSURELEVEL_H_
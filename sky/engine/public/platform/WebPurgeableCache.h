@@ -0,0 +1,35 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PUBLIC_PLATFORM_WEBPURGEABLECACHE_H_
+#define SKY_ENGINE_PUBLIC_PLATFORM_WEBPURGEABLECACHE_H_
+
+#include "WebCommon.h"
+#include "WebMemoryPressureLevel.h"
+
+namespace blink {
+
+// A cache that reports its memory usage to the engine and can give memory
+// back when the system is under memory pressure. Caches are registered with
+// registerPurgeableCache() (see Sky.h) and must unregister themselves before
+// they are destroyed.
+class WebPurgeableCache {
+public:
+    // A stable, human-readable name used for trace counters.
+    virtual const char* cacheName() const = 0;
+
+    // An estimate of the memory currently held by the cache.
+    virtual size_t memoryUsageInBytes() = 0;
+
+    // Releases memory held by the cache. Implementations must not register or
+    // unregister caches from within this call.
+    virtual void purge(WebMemoryPressureLevel) = 0;
+
+protected:
+    virtual ~WebPurgeableCache() { }
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PUBLIC_PLATFORM_WEBPURGEABLECACHE_H_
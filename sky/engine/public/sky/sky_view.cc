@@ -13,6 +13,8 @@
 #include "sky/engine/core/script/dart_controller.h"
 #include "sky/engine/core/script/dom_dart_state.h"
 #include "sky/engine/core/view/View.h"
+#include "sky/engine/platform/IdleTaskQueue.h"
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
 #include "sky/engine/platform/weborigin/KURL.h"
 #include "sky/engine/public/platform/WebInputEvent.h"
 #include "sky/engine/public/sky/sky_view_client.h"
@@ -25,7 +27,10 @@ std::unique_ptr<SkyView> SkyView::Create(SkyViewClient* client) {
 
 SkyView::SkyView(SkyViewClient* client)
     : client_(client),
+      idle_task_queue_(IdleTaskQueue::create()),
       weak_factory_(this) {
+  idle_task_queue_->setTasksPostedCallback(
+      base::Bind(&SkyView::ScheduleIdleTasks, weak_factory_.GetWeakPtr()));
 }
 
 SkyView::~SkyView() {
@@ -50,6 +55,7 @@ void SkyView::RunFromSnapshot(const WebString& name,
 
 void SkyView::BeginFrame(base::TimeTicks frame_time) {
   view_->beginFrame(frame_time);
+  PurgeableCacheRegistry::instance().traceMemoryUsage();
 }
 
 skia::RefPtr<SkPicture> SkyView::Paint() {
@@ -58,6 +64,15 @@ skia::RefPtr<SkPicture> SkyView::Paint() {
   return skia::RefPtr<SkPicture>();
 }
 
+bool SkyView::HasIdleTasks() const {
+  return idle_task_queue_->hasPendingTasks();
+}
+
+void SkyView::RunIdleTasks(base::TimeTicks deadline) {
+  TRACE_EVENT0("sky", "SkyView::RunIdleTasks");
+  idle_task_queue_->runTasks(deadline);
+}
+
 void SkyView::HandleInputEvent(const WebInputEvent& inputEvent) {
   TRACE_EVENT0("input", "SkyView::HandleInputEvent");
 
@@ -84,11 +99,12 @@ void SkyView::CreateView(const String& name) {
   DCHECK(!dart_controller_);
 
   view_ = View::create(
-      base::Bind(&SkyView::ScheduleFrame, weak_factory_.GetWeakPtr()));
+      base::Bind(&SkyView::ScheduleFrame, weak_factory_.GetWeakPtr()),
+      idle_task_queue_.get());
   view_->setDisplayMetrics(display_metrics_);
 
   dart_controller_ = adoptPtr(new DartController);
-  dart_controller_->CreateIsolateFor(adoptPtr(new DOMDartState(name)));
+  dart_controller_->CreateIsolateFor(adoptPtr(new DOMDartState(name, idle_task_queue_.get())));
   dart_controller_->InstallView(view_.get());
 
   Dart_Isolate isolate = dart_controller_->dart_state()->isolate();
@@ -101,4 +117,8 @@ void SkyView::ScheduleFrame() {
   client_->ScheduleFrame();
 }
 
+void SkyView::ScheduleIdleTasks() {
+  client_->ScheduleIdleTasks();
+}
+
 } // namespace blink
@@ -23,6 +23,7 @@
 namespace blink {
 class DartController;
 class DartLibraryProvider;
+class IdleTaskQueue;
 class SkyViewClient;
 class View;
 class WebInputEvent;
@@ -44,14 +45,20 @@ class SkyView {
   skia::RefPtr<SkPicture> Paint();
   void HandleInputEvent(const WebInputEvent& event);
 
+  bool HasIdleTasks() const;
+  void RunIdleTasks(base::TimeTicks deadline);
+
  private:
   explicit SkyView(SkyViewClient* client);
 
   void CreateView(const String& name);
   void ScheduleFrame();
+  void ScheduleIdleTasks();
 
   SkyViewClient* client_;
   SkyDisplayMetrics display_metrics_;
+  // Declared before |view_| and |dart_controller_|, which refer to it.
+  OwnPtr<IdleTaskQueue> idle_task_queue_;
   RefPtr<View> view_;
   OwnPtr<DartController> dart_controller_;
 
@@ -13,6 +13,11 @@ class SkyViewClient {
  public:
   virtual void ScheduleFrame() = 0;
 
+  // Called when there is idle work to do. The client calls
+  // SkyView::RunIdleTasks once it has finished a frame and the next one isn't
+  // due yet.
+  virtual void ScheduleIdleTasks() = 0;
+
   virtual void DidCreateIsolate(Dart_Isolate isolate) = 0;
 
  protected:
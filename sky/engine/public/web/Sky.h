@@ -32,9 +32,12 @@
 #define SKY_ENGINE_PUBLIC_WEB_SKY_H_
 
 #include "../platform/Platform.h"
+#include "../platform/WebMemoryPressureLevel.h"
 
 namespace blink {
 
+class WebPurgeableCache;
+
 // Must be called on the thread that will be the main WebKit thread before
 // using any other WebKit APIs. The provided Platform; must be
 // non-null and must remain valid until the current thread calls shutdown.
@@ -54,6 +57,15 @@ BLINK_EXPORT bool layoutTestMode();
 BLINK_EXPORT void setFontAntialiasingEnabledForTest(bool);
 BLINK_EXPORT bool fontAntialiasingEnabledForTest();
 
+// Registers a cache owned by the embedder so that it is purged along with the
+// engine's own caches. The cache must be unregistered before it is destroyed.
+BLINK_EXPORT void registerPurgeableCache(WebPurgeableCache*);
+BLINK_EXPORT void unregisterPurgeableCache(WebPurgeableCache*);
+
+// Asks every registered cache to give memory back, e.g. when the operating
+// system reports memory pressure.
+BLINK_EXPORT void purgeCaches(WebMemoryPressureLevel);
+
 // Enables the named log channel. See WebCore/platform/Logging.h for details.
 BLINK_EXPORT void enableLogChannel(const char*);
 
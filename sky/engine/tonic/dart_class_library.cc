@@ -10,6 +10,10 @@
 namespace blink {
 
 DartClassLibrary::DartClassLibrary() : provider_(nullptr) {
+  for (RecentClass& recent : recent_) {
+    recent.info = nullptr;
+    recent.type = nullptr;
+  }
 }
 
 DartClassLibrary::~DartClassLibrary() {
@@ -18,17 +22,20 @@ DartClassLibrary::~DartClassLibrary() {
   // isolate dies.
 }
 
-Dart_PersistentHandle DartClassLibrary::GetClass(const DartWrapperInfo& info) {
+Dart_PersistentHandle DartClassLibrary::GetClassSlow(
+    const DartWrapperInfo& info) {
   DCHECK(provider_);
 
   const auto& result = cache_.insert(std::make_pair(&info, nullptr));
-  if (!result.second) {
-    // Already present, return value.
-    return result.first->second;
+  if (result.second) {
+    Dart_Handle class_handle = provider_->GetClassByName(info.interface_name);
+    result.first->second = Dart_NewPersistentHandle(class_handle);
   }
-  Dart_Handle class_handle = provider_->GetClassByName(info.interface_name);
-  result.first->second = Dart_NewPersistentHandle(class_handle);
-  return result.first->second;
+
+  RecentClass& recent = recent_[RecentIndex(info)];
+  recent.info = &info;
+  recent.type = result.first->second;
+  return recent.type;
 }
 
 }  // namespace blink
@@ -5,6 +5,7 @@
 #ifndef SKY_ENGINE_TONIC_DART_CLASS_LIBRARY_H_
 #define SKY_ENGINE_TONIC_DART_CLASS_LIBRARY_H_
 
+#include <stdint.h>
 #include <unordered_map>
 #include "base/macros.h"
 #include "dart/runtime/include/dart_api.h"
@@ -19,10 +20,36 @@ class DartClassLibrary {
   ~DartClassLibrary();
 
   void set_provider(DartClassProvider* provider) { provider_ = provider; }
-  Dart_PersistentHandle GetClass(const DartWrapperInfo& info);
+
+  // Wrappers are created for every node, event and paint object handed to
+  // Dart, usually alternating between a handful of types, so the classes
+  // used most recently are kept in a small direct-mapped table in front of
+  // |cache_|.
+  Dart_PersistentHandle GetClass(const DartWrapperInfo& info) {
+    RecentClass& recent = recent_[RecentIndex(info)];
+    if (recent.info == &info)
+      return recent.type;
+    return GetClassSlow(info);
+  }
 
  private:
+  struct RecentClass {
+    const DartWrapperInfo* info;
+    Dart_PersistentHandle type;
+  };
+
+  static const size_t kRecentClassCount = 16;
+
+  static size_t RecentIndex(const DartWrapperInfo& info) {
+    // DartWrapperInfos are statics, at least pointer-aligned.
+    return (reinterpret_cast<uintptr_t>(&info) / sizeof(void*)) %
+           kRecentClassCount;
+  }
+
+  Dart_PersistentHandle GetClassSlow(const DartWrapperInfo& info);
+
   DartClassProvider* provider_;
+  RecentClass recent_[kRecentClassCount];
   std::unordered_map<const DartWrapperInfo*, Dart_PersistentHandle> cache_;
 
   DISALLOW_COPY_AND_ASSIGN(DartClassLibrary);
@@ -5,7 +5,11 @@
 #ifndef SKY_ENGINE_TONIC_DART_CONVERTER_H_
 #define SKY_ENGINE_TONIC_DART_CONVERTER_H_
 
+#include <string.h>
+
 #include <string>
+#include <type_traits>
+
 #include "sky/engine/tonic/dart_state.h"
 #include "sky/engine/tonic/dart_string.h"
 #include "sky/engine/tonic/dart_string_cache.h"
@@ -95,6 +99,9 @@ struct DartConverter<int> : public DartConverterInteger<int> {};
 template <>
 struct DartConverter<unsigned> : public DartConverterInteger<unsigned> {};
 
+template <>
+struct DartConverter<uint8_t> : public DartConverterInteger<uint8_t> {};
+
 template <>
 struct DartConverter<long long> : public DartConverterInteger<long long> {};
 
@@ -257,6 +264,80 @@ struct DartConverter<AtomicString> {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Typed data
+
+// Vectors of these types convert to and from the Dart typed data list with
+// the same element type in one copy, rather than an API call per element.
+template <typename T>
+struct DartTypedDataTraits {
+  static const bool kIsTypedData = false;
+};
+
+template <>
+struct DartTypedDataTraits<uint8_t> {
+  static const bool kIsTypedData = true;
+  static const Dart_TypedData_Type kType = Dart_TypedData_kUint8;
+};
+
+template <>
+struct DartTypedDataTraits<int> {
+  static const bool kIsTypedData = true;
+  static const Dart_TypedData_Type kType = Dart_TypedData_kInt32;
+};
+
+template <>
+struct DartTypedDataTraits<unsigned> {
+  static const bool kIsTypedData = true;
+  static const Dart_TypedData_Type kType = Dart_TypedData_kUint32;
+};
+
+template <>
+struct DartTypedDataTraits<float> {
+  static const bool kIsTypedData = true;
+  static const Dart_TypedData_Type kType = Dart_TypedData_kFloat32;
+};
+
+template <>
+struct DartTypedDataTraits<double> {
+  static const bool kIsTypedData = true;
+  static const Dart_TypedData_Type kType = Dart_TypedData_kFloat64;
+};
+
+template <typename T>
+struct DartTypedDataConverter {
+  static Dart_Handle ToDart(const Vector<T>& val) {
+    Dart_Handle list =
+        Dart_NewTypedData(DartTypedDataTraits<T>::kType, val.size());
+    if (Dart_IsError(list) || val.isEmpty())
+      return list;
+    Dart_TypedData_Type type;
+    void* data = nullptr;
+    intptr_t length = 0;
+    Dart_Handle result = Dart_TypedDataAcquireData(list, &type, &data, &length);
+    if (Dart_IsError(result))
+      return result;
+    memcpy(data, val.data(), val.size() * sizeof(T));
+    Dart_TypedDataReleaseData(list);
+    return list;
+  }
+
+  // Returns false, leaving |result| empty, if |handle| isn't a typed data list
+  // of T.
+  static bool FromDart(Dart_Handle handle, Vector<T>* result) {
+    if (Dart_GetTypeOfTypedData(handle) != DartTypedDataTraits<T>::kType)
+      return false;
+    Dart_TypedData_Type type;
+    void* data = nullptr;
+    intptr_t length = 0;
+    if (Dart_IsError(Dart_TypedDataAcquireData(handle, &type, &data, &length)))
+      return false;
+    result->append(static_cast<const T*>(data), length);
+    Dart_TypedDataReleaseData(handle);
+    return true;
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Collections
 
@@ -264,8 +345,38 @@ template <typename T>
 struct DartConverter<Vector<T>> {
   using ValueType = typename DartConverterTypes<T>::ValueType;
   using ConverterType = typename DartConverterTypes<T>::ConverterType;
+  using IsTypedData = std::integral_constant<
+      bool,
+      DartTypedDataTraits<ConverterType>::kIsTypedData &&
+          std::is_same<ValueType, ConverterType>::value>;
 
+  // Vectors of numbers become typed data lists, other vectors become Lists.
   static Dart_Handle ToDart(const Vector<ValueType>& val) {
+    return ToDart(val, IsTypedData());
+  }
+
+  // Accepts any List. Typed data lists of the same element type are copied in
+  // one go.
+  static Vector<ValueType> FromDart(Dart_Handle handle) {
+    Vector<ValueType> result;
+    FromDart(handle, &result, IsTypedData());
+    return result;
+  }
+
+  static Vector<ValueType> FromArguments(Dart_NativeArguments args,
+                                          int index,
+                                          Dart_Handle& exception,
+                                          bool auto_scope = true) {
+    // TODO(abarth): What should we do with auto_scope?
+    return FromDart(Dart_GetNativeArgument(args, index));
+  }
+
+ private:
+  static Dart_Handle ToDart(const Vector<ValueType>& val, std::true_type) {
+    return DartTypedDataConverter<ValueType>::ToDart(val);
+  }
+
+  static Dart_Handle ToDart(const Vector<ValueType>& val, std::false_type) {
     Dart_Handle list = Dart_NewList(val.size());
     if (Dart_IsError(list))
       return list;
@@ -279,28 +390,27 @@ struct DartConverter<Vector<T>> {
     return list;
   }
 
-  static Vector<ValueType> FromDart(Dart_Handle handle) {
-    Vector<ValueType> result;
+  static void FromDart(Dart_Handle handle,
+                       Vector<ValueType>* result,
+                       std::true_type) {
+    if (!DartTypedDataConverter<ValueType>::FromDart(handle, result))
+      FromDart(handle, result, std::false_type());
+  }
+
+  static void FromDart(Dart_Handle handle,
+                       Vector<ValueType>* result,
+                       std::false_type) {
     if (!Dart_IsList(handle))
-      return result;
+      return;
     intptr_t length = 0;
     Dart_ListLength(handle, &length);
-    result.reserveCapacity(length);
+    result->reserveCapacity(length);
     for (intptr_t i = 0; i < length; ++i) {
       Dart_Handle item = Dart_ListGetAt(handle, i);
       DCHECK(!Dart_IsError(item));
       DCHECK(item);
-      result.append(DartConverter<ConverterType>::FromDart(item));
+      result->append(DartConverter<ConverterType>::FromDart(item));
     }
-    return result;
-  }
-
-  static Vector<ValueType> FromArguments(Dart_NativeArguments args,
-                                          int index,
-                                          Dart_Handle& exception,
-                                          bool auto_scope = true) {
-    // TODO(abarth): What should we do with auto_scope?
-    return FromDart(Dart_GetNativeArgument(args, index));
   }
 };
 
@@ -41,6 +41,7 @@
 #include "sky/engine/core/script/dart_init.h"
 #include "sky/engine/platform/LayoutTestSupport.h"
 #include "sky/engine/platform/Logging.h"
+#include "sky/engine/platform/PurgeableCacheRegistry.h"
 #include "sky/engine/public/platform/Platform.h"
 #include "sky/engine/wtf/Assertions.h"
 #include "sky/engine/wtf/CryptographicallyRandomNumber.h"
@@ -127,6 +128,9 @@ void initialize(Platform* platform)
     WTF::initialize();
     WTF::initializeMainThread();
 
+    // Create the registry before any cache can register from another thread.
+    PurgeableCacheRegistry::instance();
+
     DEFINE_STATIC_LOCAL(CoreInitializer, initializer, ());
     initializer.init();
 
@@ -175,6 +179,22 @@ bool fontAntialiasingEnabledForTest()
     return LayoutTestSupport::isFontAntialiasingEnabledForTest();
 }
 
+void registerPurgeableCache(WebPurgeableCache* cache)
+{
+    PurgeableCacheRegistry::instance().add(cache);
+}
+
+void unregisterPurgeableCache(WebPurgeableCache* cache)
+{
+    PurgeableCacheRegistry::instance().remove(cache);
+}
+
+void purgeCaches(WebMemoryPressureLevel level)
+{
+    ASSERT(isMainThread());
+    PurgeableCacheRegistry::instance().purge(level);
+}
+
 void enableLogChannel(const char* name)
 {
 #if !LOG_DISABLED
@@ -1628,15 +1628,16 @@ class RenderView extends RenderObject with RenderObjectWithChildMixin<RenderBox>
       canvas.paintChild(child, offset.toPoint());
   }
 
+  static final int _paintFrameTraceName = sky.tracing.registerName('RenderView.paintFrame');
   void paintFrame() {
-    sky.tracing.begin('RenderView.paintFrame');
+    sky.tracing.beginEvent(_paintFrameTraceName);
     try {
       sky.PictureRecorder recorder = new sky.PictureRecorder();
       PaintingCanvas canvas = new PaintingCanvas(recorder, paintBounds);
       canvas.drawPaintingNode(paintingNode, Point.origin);
       sky.view.picture = recorder.endRecording();
     } finally {
-      sky.tracing.end('RenderView.paintFrame');
+      sky.tracing.endEvent(_paintFrameTraceName);
     }
   }
 
@@ -1644,6 +1645,11 @@ class RenderView extends RenderObject with RenderObjectWithChildMixin<RenderBox>
 }
 
 // HELPER METHODS FOR RENDERBOX CONTAINERS
+
+// Containers with at least this many children find the ones under a point
+// with a sky.RectIndex rather than by testing every child's bounds.
+const int _kMinChildrenForHitTestIndex = 32;
+
 abstract class RenderBoxContainerDefaultsMixin<ChildType extends RenderBox, ParentDataType extends ContainerParentDataMixin<ChildType>> implements ContainerRenderObjectMixin<ChildType, ParentDataType> {
 
   // This class, by convention, doesn't override any members of the superclass.
@@ -1683,19 +1689,56 @@ abstract class RenderBoxContainerDefaultsMixin<ChildType extends RenderBox, Pare
 
   void defaultHitTestChildren(HitTestResult result, { Point position }) {
     // the x, y parameters have the top left of the node's box as the origin
+    if (childCount >= _kMinChildrenForHitTestIndex) {
+      _hitTestIndexedChildren(result, position);
+      return;
+    }
     ChildType child = lastChild;
     while (child != null) {
       assert(child.parentData is ParentDataType);
-      Rect childBounds = child.parentData.position & child.size;
-      if (childBounds.contains(position)) {
-        if (child.hitTest(result, position: new Point(position.x - child.parentData.position.x,
-                                                          position.y - child.parentData.position.y)))
-          break;
-      }
+      if (_hitTestChild(child, result, position))
+        break;
       child = child.parentData.previousSibling;
     }
   }
 
+  bool _hitTestChild(ChildType child, HitTestResult result, Point position) {
+    Rect childBounds = child.parentData.position & child.size;
+    if (!childBounds.contains(position))
+      return false;
+    return child.hitTest(result, position: new Point(position.x - child.parentData.position.x,
+                                                     position.y - child.parentData.position.y));
+  }
+
+  // The bounds of each child, by its index in _hitTestIndexChildren. Rebuilt by
+  // the first hit test after a layout, since only layout moves children.
+  sky.RectIndex _hitTestIndex;
+  List<ChildType> _hitTestIndexChildren;
+  int _hitTestIndexGeneration;
+
+  void _hitTestIndexedChildren(HitTestResult result, Point position) {
+    if (_hitTestIndex == null || _hitTestIndexGeneration != RenderObject.layoutGeneration) {
+      if (_hitTestIndex == null)
+        _hitTestIndex = new sky.RectIndex();
+      _hitTestIndex.clear();
+      _hitTestIndexChildren = new List<ChildType>();
+      ChildType child = firstChild;
+      while (child != null) {
+        assert(child.parentData is ParentDataType);
+        _hitTestIndex.add(child.parentData.position & child.size);
+        _hitTestIndexChildren.add(child);
+        child = child.parentData.nextSibling;
+      }
+      _hitTestIndexGeneration = RenderObject.layoutGeneration;
+    }
+    // Hits come back in child order, and later children are on top.
+    List<int> hits = _hitTestIndex.hitTest(position);
+    for (int i = hits.length - 1; i >= 0; --i) {
+      if (_hitTestChild(_hitTestIndexChildren[hits[i]], result, position))
+        break;
+    }
+  }
+
   void defaultPaint(PaintingCanvas canvas, Offset offset) {
     RenderBox child = firstChild;
     while (child != null) {
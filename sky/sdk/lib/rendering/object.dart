@@ -107,6 +107,10 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
   }
 
   static List<RenderObject> _nodesNeedingLayout = new List<RenderObject>();
+  // Changes whenever a render object might have moved, resized, or gained or
+  // lost a child, so anything cached from a layout can tell it's stale.
+  static int _layoutGeneration = 0;
+  static int get layoutGeneration => _layoutGeneration;
   bool _needsLayout = true;
   bool get needsLayout => _needsLayout;
   RenderObject _relayoutSubtreeRoot;
@@ -134,6 +138,7 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
       return;
     }
     _needsLayout = true;
+    _layoutGeneration += 1;
     assert(_relayoutSubtreeRoot != null);
     if (_relayoutSubtreeRoot != this) {
       final parent = this.parent; // TODO(ianh): Remove this once the analyzer is cleverer
@@ -166,9 +171,11 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
     _nodesNeedingPaint.add(this);
     scheduler.ensureVisualUpdate();
   }
+  static final int _flushLayoutTraceName = sky.tracing.registerName('RenderObject.flushLayout');
   static void flushLayout() {
-    sky.tracing.begin('RenderObject.flushLayout');
+    sky.tracing.beginEvent(_flushLayoutTraceName);
     _debugDoingLayout = true;
+    _layoutGeneration += 1;
     try {
       List<RenderObject> dirtyNodes = _nodesNeedingLayout;
       _nodesNeedingLayout = new List<RenderObject>();
@@ -178,7 +185,7 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
       });
     } finally {
       _debugDoingLayout = false;
-      sky.tracing.end('RenderObject.flushLayout');
+      sky.tracing.endEvent(_flushLayoutTraceName);
     }
   }
   void layoutWithoutResize() {
@@ -338,8 +345,9 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
     }
   }
 
+  static final int _flushPaintTraceName = sky.tracing.registerName('RenderObject.flushPaint');
   static void flushPaint() {
-    sky.tracing.begin('RenderObject.flushPaint');
+    sky.tracing.beginEvent(_flushPaintTraceName);
     _debugDoingPaint = true;
     try {
       List<RenderObject> dirtyNodes = _nodesNeedingPaint;
@@ -351,7 +359,7 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
       assert(_nodesNeedingPaint.length == 0);
     } finally {
       _debugDoingPaint = false;
-      sky.tracing.end('RenderObject.flushPaint');
+      sky.tracing.endEvent(_flushPaintTraceName);
     }
   }
 
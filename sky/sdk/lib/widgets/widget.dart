@@ -208,9 +208,10 @@ abstract class Widget {
   /// chain being correctly configured at this point.
   void walkChildren(WidgetTreeWalker walker) { }
 
+  static final int _notifyMountStatusChangedTraceName = sky.tracing.registerName('Widget._notifyMountStatusChanged');
   static void _notifyMountStatusChanged() {
     try {
-      sky.tracing.begin("Widget._notifyMountStatusChanged");
+      sky.tracing.beginEvent(_notifyMountStatusChangedTraceName);
       _notifyingMountStatus = true;
       for (Widget node in _mountedChanged) {
         if (node._wasMounted != node._mounted) {
@@ -224,7 +225,7 @@ abstract class Widget {
       _mountedChanged.clear();
     } finally {
       _notifyingMountStatus = false;
-      sky.tracing.end("Widget._notifyMountStatusChanged");
+      sky.tracing.endEvent(_notifyMountStatusChangedTraceName);
     }
     GlobalKey._notifyListeners();
   }
@@ -758,6 +759,7 @@ void _absorbDirtyComponents(List<Component> list) {
   list.sort((Component a, Component b) => a._order - b._order);
 }
 
+final int _buildDirtyComponentsTraceName = sky.tracing.registerName('Widgets._buildDirtyComponents');
 void _buildDirtyComponents() {
   Stopwatch sw;
   if (_shouldLogRenderDuration)
@@ -765,7 +767,7 @@ void _buildDirtyComponents() {
 
   _inRenderDirtyComponents = true;
   try {
-    sky.tracing.begin('Widgets._buildDirtyComponents');
+    sky.tracing.beginEvent(_buildDirtyComponentsTraceName);
     List<Component> sortedDirtyComponents = new List<Component>();
     _absorbDirtyComponents(sortedDirtyComponents);
     int index = 0;
@@ -784,7 +786,7 @@ void _buildDirtyComponents() {
   } finally {
     _buildScheduled = false;
     _inRenderDirtyComponents = false;
-    sky.tracing.end('Widgets._buildDirtyComponents');
+    sky.tracing.endEvent(_buildDirtyComponentsTraceName);
   }
 
   Widget._notifyMountStatusChanged();
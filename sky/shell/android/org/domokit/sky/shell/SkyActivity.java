@@ -5,6 +5,7 @@
 package org.domokit.sky.shell;
 
 import android.app.Activity;
+import android.content.ComponentCallbacks2;
 import android.content.Intent;
 import android.os.Build;
 import android.os.Bundle;
@@ -14,6 +15,7 @@ import android.view.WindowManager;
 import org.chromium.base.PathUtils;
 import org.chromium.mojom.sky.EventType;
 import org.chromium.mojom.sky.InputEvent;
+import org.chromium.mojom.sky.MemoryPressureLevel;
 
 import org.domokit.activity.ActivityImpl;
 
@@ -93,6 +95,31 @@ public class SkyActivity extends Activity {
         }
     }
 
+    @Override
+    public void onTrimMemory(int level) {
+        super.onTrimMemory(level);
+        if (mView == null) {
+            return;
+        }
+        // The levels aren't ordered by severity: UI_HIDDEN and BACKGROUND are
+        // above RUNNING_CRITICAL but only mean the app left the foreground.
+        switch (level) {
+            case ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL:
+            case ComponentCallbacks2.TRIM_MEMORY_COMPLETE:
+                mView.getEngine().onMemoryPressure(MemoryPressureLevel.CRITICAL);
+                break;
+            case ComponentCallbacks2.TRIM_MEMORY_RUNNING_MODERATE:
+            case ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW:
+            case ComponentCallbacks2.TRIM_MEMORY_UI_HIDDEN:
+            case ComponentCallbacks2.TRIM_MEMORY_BACKGROUND:
+            case ComponentCallbacks2.TRIM_MEMORY_MODERATE:
+                mView.getEngine().onMemoryPressure(MemoryPressureLevel.MODERATE);
+                break;
+            default:
+                break;
+        }
+    }
+
     /**
       * Override this function to customize startup behavior.
       */
@@ -4,11 +4,16 @@
 
 #include "sky/shell/gpu/rasterizer.h"
 
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/trace_event/trace_event.h"
 #include "sky/shell/gpu/ganesh_context.h"
 #include "sky/shell/gpu/ganesh_surface.h"
 #include "sky/shell/gpu/picture_serializer.h"
+#include "sky/shell/switches.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "ui/gl/gl_bindings.h"
 #include "ui/gl/gl_context.h"
@@ -19,15 +24,91 @@ namespace sky {
 namespace shell {
 namespace {
 
+const char kDefaultCapturePath[] = "frame.skp";
+
 gfx::Size GetSize(SkPicture* picture) {
   const SkRect& rect = picture->cullRect();
   return gfx::Size(rect.width(), rect.height());
 }
 
+// Counts the text draws of a picture without rasterizing them.
+class TextBlitCounter : public SkCanvas {
+ public:
+  explicit TextBlitCounter(const SkIRect& bounds)
+      : SkCanvas(bounds.width(), bounds.height()), blobs_(0), runs_(0) {}
+
+  // Text blobs, which is how the engine records text.
+  int blobs() const { return blobs_; }
+  // Any other text draws.
+  int runs() const { return runs_; }
+
+ protected:
+  void onDrawText(const void*, size_t, SkScalar, SkScalar,
+                  const SkPaint&) override {
+    ++runs_;
+  }
+  void onDrawPosText(const void*, size_t, const SkPoint[],
+                     const SkPaint&) override {
+    ++runs_;
+  }
+  void onDrawPosTextH(const void*, size_t, const SkScalar[], SkScalar,
+                      const SkPaint&) override {
+    ++runs_;
+  }
+  void onDrawTextOnPath(const void*, size_t, const SkPath&, const SkMatrix*,
+                        const SkPaint&) override {
+    ++runs_;
+  }
+  void onDrawTextBlob(const SkTextBlob*, SkScalar, SkScalar,
+                      const SkPaint&) override {
+    ++blobs_;
+  }
+
+ private:
+  int blobs_;
+  int runs_;
+
+  DISALLOW_COPY_AND_ASSIGN(TextBlitCounter);
+};
+
+// Traces the text draws of a rasterized frame and the number of glyphs in
+// Skia's glyph cache afterwards. Counting walks the picture again, so it only
+// happens while the category is being traced.
+void TraceText(SkPicture* picture) {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("sky.text"),
+                                     &enabled);
+  if (!enabled)
+    return;
+
+  TextBlitCounter counter(picture->cullRect().roundOut());
+  picture->playback(&counter);
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("sky.text"), "TextBlits", "blobs",
+                 counter.blobs(), "runs", counter.runs());
+  TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("sky.text"), "GlyphCacheGlyphs",
+                 SkGraphics::GetFontCacheCountUsed());
+}
+
 }  // namespace
 
 Rasterizer::Rasterizer()
-    : share_group_(new gfx::GLShareGroup()), weak_factory_(this) {
+    : share_group_(new gfx::GLShareGroup()),
+      frame_count_(0),
+      capture_frame_(-1),
+      weak_factory_(this) {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (command_line.HasSwitch(switches::kCaptureFrame)) {
+    if (!base::StringToInt(
+            command_line.GetSwitchValueASCII(switches::kCaptureFrame),
+            &capture_frame_)) {
+      LOG(ERROR) << "Invalid --" << switches::kCaptureFrame;
+      capture_frame_ = -1;
+    }
+    capture_path_ = command_line.GetSwitchValueASCII(switches::kCapturePath);
+    if (capture_path_.empty())
+      capture_path_ = kDefaultCapturePath;
+  }
 }
 
 Rasterizer::~Rasterizer() {
@@ -60,7 +141,11 @@ void Rasterizer::Draw(skia::RefPtr<SkPicture> picture) {
   DrawPicture(picture.get());
   surface_->SwapBuffers();
 
-  // SerializePicture("/data/data/org.domokit.sky.demo/cache/layer0.skp", picture.get());
+  if (frame_count_++ == capture_frame_) {
+    SerializePicture(capture_path_.c_str(), picture.get());
+    LOG(INFO) << "Captured frame " << capture_frame_ << " to "
+              << capture_path_;
+  }
 }
 
 void Rasterizer::DrawPicture(SkPicture* picture) {
@@ -68,6 +153,7 @@ void Rasterizer::DrawPicture(SkPicture* picture) {
   SkCanvas* canvas = ganesh_surface_->canvas();
   canvas->drawPicture(picture);
   canvas->flush();
+  TraceText(picture);
 }
 
 void Rasterizer::OnOutputSurfaceDestroyed() {
@@ -5,6 +5,8 @@
 #ifndef SKY_SHELL_GPU_RASTERIZER_H_
 #define SKY_SHELL_GPU_RASTERIZER_H_
 
+#include <string>
+
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "skia/ext/refptr.h"
@@ -48,6 +50,12 @@ class Rasterizer : public GPUDelegate {
   scoped_ptr<GaneshContext> ganesh_context_;
   scoped_ptr<GaneshSurface> ganesh_surface_;
 
+  // Frames drawn so far, and the frame to serialize to |capture_path_| (-1 if
+  // none). See switches::kCaptureFrame.
+  int frame_count_;
+  int capture_frame_;
+  std::string capture_path_;
+
   base::WeakPtrFactory<Rasterizer> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(Rasterizer);
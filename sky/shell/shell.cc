@@ -5,10 +5,13 @@
 #include "sky/shell/shell.h"
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/single_thread_task_runner.h"
+#include "mojo/common/lock_free_task_runner.h"
 #include "mojo/common/message_pump_mojo.h"
 #include "mojo/edk/embedder/embedder.h"
 #include "mojo/edk/embedder/simple_platform_support.h"
+#include "sky/shell/switches.h"
 #include "sky/shell/ui/engine.h"
 
 namespace sky {
@@ -17,8 +20,13 @@ namespace {
 
 static Shell* g_shell = nullptr;
 
-scoped_ptr<base::MessagePump> CreateMessagePumpMojo() {
-  return make_scoped_ptr(new mojo::common::MessagePumpMojo);
+scoped_ptr<base::MessagePump> CreateMessagePumpMojo(
+    scoped_refptr<mojo::common::LockFreeTaskRunner> task_runner) {
+  scoped_ptr<mojo::common::MessagePumpMojo> pump(
+      new mojo::common::MessagePumpMojo);
+  if (task_runner)
+    pump->SetTaskRunner(task_runner);
+  return pump.Pass();
 }
 
 }  // namespace
@@ -29,14 +37,14 @@ Shell::Shell(scoped_ptr<ServiceProviderContext> service_provider_context)
   mojo::embedder::Init(scoped_ptr<mojo::embedder::PlatformSupport>(
       new mojo::embedder::SimplePlatformSupport()));
 
-  base::Thread::Options options;
-  options.message_pump_factory = base::Bind(&CreateMessagePumpMojo);
+  bool lock_free = base::CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kEnableLockFreeTaskQueue);
 
   gpu_thread_.reset(new base::Thread("gpu_thread"));
-  gpu_thread_->StartWithOptions(options);
+  gpu_task_runner_ = StartThread(gpu_thread_.get(), lock_free);
 
   ui_thread_.reset(new base::Thread("ui_thread"));
-  ui_thread_->StartWithOptions(options);
+  ui_task_runner_ = StartThread(ui_thread_.get(), lock_free);
 
   ui_task_runner()->PostTask(FROM_HERE, base::Bind(&Engine::Init));
 }
@@ -44,6 +52,29 @@ Shell::Shell(scoped_ptr<ServiceProviderContext> service_provider_context)
 Shell::~Shell() {
 }
 
+scoped_refptr<base::SingleThreadTaskRunner> Shell::StartThread(
+    base::Thread* thread,
+    bool lock_free) {
+  scoped_refptr<mojo::common::LockFreeTaskRunner> lock_free_task_runner;
+  if (lock_free)
+    lock_free_task_runner = new mojo::common::LockFreeTaskRunner;
+
+  base::Thread::Options options;
+  options.message_pump_factory =
+      base::Bind(&CreateMessagePumpMojo, lock_free_task_runner);
+  thread->StartWithOptions(options);
+
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      thread->message_loop()->task_runner();
+  if (!lock_free_task_runner)
+    return task_runner;
+  // The pump binds itself to the runner on the new thread. Wait for that so
+  // nothing is posted to an unbound runner.
+  thread->WaitUntilThreadStarted();
+  lock_free_task_runner->SetDelayedTaskRunner(task_runner);
+  return lock_free_task_runner;
+}
+
 void Shell::Init(scoped_ptr<ServiceProviderContext> service_provider_context) {
   g_shell = new Shell(service_provider_context.Pass());
 }
@@ -12,6 +12,12 @@
 #include "base/threading/thread.h"
 #include "sky/shell/service_provider.h"
 
+namespace mojo {
+namespace common {
+class LockFreeTaskRunner;
+}  // namespace common
+}  // namespace mojo
+
 namespace sky {
 namespace shell {
 class ServiceProviderContext;
@@ -25,11 +31,11 @@ class Shell {
   static Shell& Shared();
 
   scoped_refptr<base::SingleThreadTaskRunner> gpu_task_runner() const {
-    return gpu_thread_->message_loop()->task_runner();
+    return gpu_task_runner_;
   }
 
   scoped_refptr<base::SingleThreadTaskRunner> ui_task_runner() const {
-    return ui_thread_->message_loop()->task_runner();
+    return ui_task_runner_;
   }
 
   ServiceProviderContext* service_provider_context() const {
@@ -42,8 +48,14 @@ class Shell {
   void InitGPU(const base::Thread::Options& options);
   void InitUI(const base::Thread::Options& options);
 
+  static scoped_refptr<base::SingleThreadTaskRunner> StartThread(
+      base::Thread* thread,
+      bool lock_free);
+
   scoped_ptr<base::Thread> gpu_thread_;
   scoped_ptr<base::Thread> ui_thread_;
+  scoped_refptr<base::SingleThreadTaskRunner> gpu_task_runner_;
+  scoped_refptr<base::SingleThreadTaskRunner> ui_task_runner_;
   scoped_ptr<ServiceProviderContext> service_provider_context_;
 
   DISALLOW_COPY_AND_ASSIGN(Shell);
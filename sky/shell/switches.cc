@@ -8,6 +8,13 @@ namespace sky {
 namespace shell {
 namespace switches {
 
+// Serializes the SkPicture of the given frame (counting from 0) to the file
+// named by --capture-path, for use with sky/tools/skp_profiler.
+const char kCaptureFrame[] = "capture-frame";
+const char kCapturePath[] = "capture-path";
+// Posts tasks for the UI and GPU threads through a lock-free queue instead of
+// the MessageLoop's locked incoming queue.
+const char kEnableLockFreeTaskQueue[] = "enable-lock-free-task-queue";
 const char kHelp[] = "help";
 const char kNonInteractive[] = "non-interactive";
 const char kPackageRoot[] = "package-root";
@@ -9,6 +9,9 @@ namespace sky {
 namespace shell {
 namespace switches {
 
+extern const char kCaptureFrame[];
+extern const char kCapturePath[];
+extern const char kEnableLockFreeTaskQueue[];
 extern const char kHelp[];
 extern const char kPackageRoot[];
 extern const char kNonInteractive[];
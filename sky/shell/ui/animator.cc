@@ -10,6 +10,16 @@
 
 namespace sky {
 namespace shell {
+namespace {
+
+// Frames aren't synchronized to vsync, so idle periods assume 60Hz.
+const int64 kFrameIntervalMicroseconds = 16667;
+
+// The longest idle period when no frame is pending, so that a frame requested
+// meanwhile isn't held up for long.
+const int64 kMaxIdlePeriodMilliseconds = 50;
+
+}  // namespace
 
 Animator::Animator(const Engine::Config& config, Engine* engine)
     : config_(config),
@@ -17,6 +27,7 @@ Animator::Animator(const Engine::Config& config, Engine* engine)
       engine_requested_frame_(false),
       frame_in_progress_(false),
       paused_(false),
+      idle_period_scheduled_(false),
       weak_factory_(this) {
 }
 
@@ -38,6 +49,12 @@ void Animator::RequestFrame() {
   }
 }
 
+void Animator::RequestIdlePeriod() {
+  // OnFrameComplete() schedules the idle period once the frame is done.
+  if (!frame_in_progress_)
+    ScheduleIdlePeriod(base::TimeDelta());
+}
+
 void Animator::Stop() {
   paused_ = true;
   engine_requested_frame_ = false;
@@ -59,7 +76,8 @@ void Animator::BeginFrame() {
   engine_requested_frame_ = false;
   TRACE_EVENT_ASYNC_END0("sky", "Frame request pending", this);
 
-  engine_->BeginFrame(base::TimeTicks::Now());
+  last_frame_time_ = base::TimeTicks::Now();
+  engine_->BeginFrame(last_frame_time_);
   config_.gpu_task_runner->PostTaskAndReply(
       FROM_HERE,
       base::Bind(&GPUDelegate::Draw, config_.gpu_delegate, engine_->Paint()),
@@ -69,13 +87,52 @@ void Animator::BeginFrame() {
 void Animator::OnFrameComplete() {
   DCHECK(frame_in_progress_);
   frame_in_progress_ = false;
-  if (paused_)
-    return;
-
-  if (engine_requested_frame_) {
+  if (!paused_ && engine_requested_frame_) {
     frame_in_progress_ = true;
     BeginFrame();
+    return;
   }
+
+  if (engine_->HasIdleTasks())
+    ScheduleIdlePeriod(base::TimeDelta());
+}
+
+void Animator::ScheduleIdlePeriod(base::TimeDelta delay) {
+  if (idle_period_scheduled_)
+    return;
+  idle_period_scheduled_ = true;
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&Animator::RunIdleTasks, weak_factory_.GetWeakPtr()), delay);
+}
+
+void Animator::RunIdleTasks() {
+  idle_period_scheduled_ = false;
+  // A frame started since the idle period was scheduled. It schedules another
+  // one when it completes.
+  if (frame_in_progress_)
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  engine_->RunIdleTasks(IdleDeadline(now));
+
+  // Tasks left over wait for the next frame, or at least a frame interval, so
+  // that idle tasks that keep reposting themselves don't spin the thread.
+  if (engine_->HasIdleTasks()) {
+    ScheduleIdlePeriod(
+        base::TimeDelta::FromMicroseconds(kFrameIntervalMicroseconds));
+  }
+}
+
+base::TimeTicks Animator::IdleDeadline(base::TimeTicks now) const {
+  base::TimeDelta interval =
+      base::TimeDelta::FromMicroseconds(kFrameIntervalMicroseconds);
+  // With no frame pending, nothing is due, but keep the period short enough
+  // that a frame requested during it starts promptly.
+  if (!engine_requested_frame_ || last_frame_time_.is_null())
+    return now + base::TimeDelta::FromMilliseconds(kMaxIdlePeriodMilliseconds);
+  // Otherwise the idle period ends when the next frame is due.
+  return last_frame_time_ + interval * ((now - last_frame_time_) / interval + 1);
 }
 
 }  // namespace shell
@@ -17,6 +17,9 @@ class Animator {
   ~Animator();
 
   void RequestFrame();
+  // Runs the engine's idle tasks after the current frame, if any, is done and
+  // before the next one is due.
+  void RequestIdlePeriod();
 
   void Start();
   void Stop();
@@ -25,11 +28,17 @@ class Animator {
   void BeginFrame();
   void OnFrameComplete();
 
+  void ScheduleIdlePeriod(base::TimeDelta delay);
+  void RunIdleTasks();
+  base::TimeTicks IdleDeadline(base::TimeTicks now) const;
+
   Engine::Config config_;
   Engine* engine_;
   bool engine_requested_frame_;
   bool frame_in_progress_;
   bool paused_;
+  bool idle_period_scheduled_;
+  base::TimeTicks last_frame_time_;
 
   base::WeakPtrFactory<Animator> weak_factory_;
 
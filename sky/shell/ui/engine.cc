@@ -110,6 +110,15 @@ skia::RefPtr<SkPicture> Engine::Paint() {
   return skia::AdoptRef(recorder.endRecordingAsPicture());
 }
 
+bool Engine::HasIdleTasks() const {
+  return sky_view_ && sky_view_->HasIdleTasks();
+}
+
+void Engine::RunIdleTasks(base::TimeTicks deadline) {
+  if (sky_view_)
+    sky_view_->RunIdleTasks(deadline);
+}
+
 void Engine::ConnectToEngine(mojo::InterfaceRequest<SkyEngine> request) {
   binding_.Bind(request.Pass());
 }
@@ -210,6 +219,13 @@ void Engine::OnActivityResumed() {
   StartAnimatorIfPossible();
 }
 
+void Engine::OnMemoryPressure(MemoryPressureLevel level) {
+  TRACE_EVENT0("sky", "Engine::OnMemoryPressure");
+  blink::purgeCaches(level == MEMORY_PRESSURE_LEVEL_CRITICAL
+                         ? blink::WebMemoryPressureLevelCritical
+                         : blink::WebMemoryPressureLevelModerate);
+}
+
 void Engine::DidCreateIsolate(Dart_Isolate isolate) {
   Internals::Create(isolate,
                     CreateServiceProvider(config_.service_provider_context),
@@ -229,6 +245,10 @@ void Engine::ScheduleFrame() {
   animator_->RequestFrame();
 }
 
+void Engine::ScheduleIdleTasks() {
+  animator_->RequestIdlePeriod();
+}
+
 mojo::NavigatorHost* Engine::NavigatorHost() {
   return this;
 }
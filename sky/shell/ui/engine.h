@@ -56,6 +56,9 @@ class Engine : public UIDelegate,
   void BeginFrame(base::TimeTicks frame_time);
   skia::RefPtr<SkPicture> Paint();
 
+  bool HasIdleTasks() const;
+  void RunIdleTasks(base::TimeTicks deadline);
+
  private:
   // UIDelegate implementation:
   void ConnectToEngine(mojo::InterfaceRequest<SkyEngine> request) override;
@@ -74,9 +77,11 @@ class Engine : public UIDelegate,
 
   void OnActivityPaused() override;
   void OnActivityResumed() override;
+  void OnMemoryPressure(MemoryPressureLevel level) override;
 
   // SkyViewClient methods:
   void ScheduleFrame() override;
+  void ScheduleIdleTasks() override;
   void DidCreateIsolate(Dart_Isolate isolate) override;
 
   // Services methods:
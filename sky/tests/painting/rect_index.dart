@@ -0,0 +1,34 @@
+import "../resources/third_party/unittest/unittest.dart";
+import "../resources/unit.dart";
+
+import "dart:sky";
+import "dart:typed_data";
+
+void main() {
+  initUnit();
+
+  RectIndex index = new RectIndex();
+  index.add(new Rect.fromLTRB(0.0, 0.0, 50.0, 50.0));
+  index.add(new Rect.fromLTRB(100.0, 100.0, 150.0, 150.0));
+  index.add(new Rect.fromLTRB(25.0, 25.0, 75.0, 75.0));
+
+  test("hitTest should return the rects under a point in order", () {
+    expect(index.length, equals(3));
+    expect(index.hitTest(new Point(30.0, 30.0)), equals([0, 2]));
+    expect(index.hitTest(new Point(125.0, 125.0)), equals([1]));
+    expect(index.hitTest(new Point(90.0, 90.0)), isEmpty);
+  });
+
+  test("query should return the rects inside an area in order", () {
+    expect(index.query(new Rect.fromLTRB(60.0, 60.0, 110.0, 110.0)),
+           equals([1, 2]));
+  });
+
+  test("results should be fixed-length Uint32Lists", () {
+    List<int> hits = index.hitTest(new Point(30.0, 30.0));
+    expect(hits, new isInstanceOf<Uint32List>());
+    expect(() => hits.add(1), throwsUnsupportedError);
+    List<int> copy = new List<int>.from(hits)..add(1);
+    expect(copy, equals([0, 2, 1]));
+  });
+}
@@ -0,0 +1,309 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays SkPictures captured with sky_shell --capture-frame through
+// skia::BenchmarkingCanvas on the CPU backend and reports the most expensive
+// draw ops, save layers and paints. The first replay starts with an empty
+// glyph cache, so comparing it with the others shows the cost of rasterizing
+// glyphs in text-heavy frames. With --paragraphs, it also profiles a frame it
+// records itself that is mostly paragraphs of text.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/json/json_writer.h"
+#include "base/macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "skia/ext/benchmarking_canvas.h"
+#include "skia/ext/refptr.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkGraphics.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+
+namespace {
+
+// Number of times each picture is replayed; op times are averaged.
+const char kRepeat[] = "repeat";
+// Number of entries to print in each report.
+const char kTop[] = "top";
+// Also profiles the frame recorded by RecordParagraphFrame().
+const char kParagraphs[] = "paragraphs";
+
+const int kDefaultRepeat = 10;
+const int kDefaultTop = 10;
+
+// The size of a phone screen, and the layout of the text that fills it.
+const int kFrameWidth = 1080;
+const int kFrameHeight = 1920;
+const SkScalar kMargin = 32;
+const SkScalar kLineHeight = 1.4f;
+const int kLinesPerParagraph = 6;
+
+void Usage() {
+  fprintf(stderr,
+          "Usage: skp_profiler [--%s=N] [--%s=N] [--%s] PICTURE.skp...\n",
+          kRepeat, kTop, kParagraphs);
+}
+
+// Records a screen of paragraphs the way the engine records text: each line
+// is one text blob of horizontally positioned glyphs, and the paragraphs
+// alternate between a few sizes and colors.
+skia::RefPtr<SkPicture> RecordParagraphFrame() {
+  static const char kLine[] =
+      "The quick brown fox jumps over the lazy dog, 0123456789 times.";
+  static const SkScalar kTextSizes[] = {14, 16, 20};
+  static const SkColor kColors[] = {SK_ColorBLACK, 0xFF424242, 0xFF1565C0};
+
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(kFrameWidth, kFrameHeight);
+  canvas->clear(SK_ColorWHITE);
+
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  paint.setSubpixelText(true);
+  SkScalar y = kMargin;
+  for (int line = 0;; ++line) {
+    int paragraph = line / kLinesPerParagraph;
+    paint.setTextSize(kTextSizes[paragraph % arraysize(kTextSizes)]);
+    paint.setColor(kColors[paragraph % arraysize(kColors)]);
+    y += paint.getTextSize() * kLineHeight;
+    if (line % kLinesPerParagraph == 0)
+      y += paint.getTextSize();
+    if (y > kFrameHeight - kMargin)
+      break;
+
+    paint.setTextEncoding(SkPaint::kUTF8_TextEncoding);
+    int count = paint.textToGlyphs(kLine, strlen(kLine), nullptr);
+    std::vector<uint16_t> glyphs(count);
+    paint.textToGlyphs(kLine, strlen(kLine), glyphs.data());
+    paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+    std::vector<SkScalar> advances(count);
+    paint.getTextWidths(glyphs.data(), count * sizeof(uint16_t),
+                        advances.data());
+
+    SkTextBlobBuilder builder;
+    const SkTextBlobBuilder::RunBuffer& run =
+        builder.allocRunPosH(paint, count, y);
+    SkScalar x = kMargin;
+    for (int i = 0; i < count; ++i) {
+      run.glyphs[i] = glyphs[i];
+      run.pos[i] = x;
+      x += advances[i];
+    }
+    skia::RefPtr<SkTextBlob> blob = skia::AdoptRef(builder.build());
+    canvas->drawTextBlob(blob.get(), 0, 0, paint);
+  }
+  return skia::AdoptRef(recorder.endRecordingAsPicture());
+}
+
+// Decodes the images embedded by sky/shell/gpu/picture_serializer.cc, which
+// are PNG, or the original encoded data of lazily decoded images.
+bool DecodeBitmap(const void* data, size_t size, SkBitmap* bitmap) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  if (gfx::PNGCodec::Decode(bytes, size, bitmap))
+    return true;
+  scoped_ptr<SkBitmap> jpeg(gfx::JPEGCodec::Decode(bytes, size));
+  if (!jpeg)
+    return false;
+  *bitmap = *jpeg;
+  return true;
+}
+
+struct Op {
+  std::string name;
+  std::string paint;
+  double time_ms;
+};
+
+std::string PaintString(const base::DictionaryValue& op) {
+  const base::ListValue* params = nullptr;
+  if (!op.GetList("info", &params))
+    return std::string();
+  for (size_t i = 0; i < params->GetSize(); ++i) {
+    const base::DictionaryValue* param = nullptr;
+    const base::Value* paint = nullptr;
+    if (params->GetDictionary(i, &param) && param->Get("paint", &paint)) {
+      std::string json;
+      base::JSONWriter::Write(*paint, &json);
+      return json;
+    }
+  }
+  return std::string();
+}
+
+struct Profile {
+  // Times are averaged over the runs.
+  std::vector<Op> ops;
+  // The time of the first run, with an empty glyph cache.
+  double cold_ms;
+};
+
+bool IsTextOp(const Op& op) {
+  return op.name.find("Text") != std::string::npos;
+}
+
+// Replays |picture| |repeat| times.
+Profile Run(SkPicture* picture, int repeat) {
+  SkIRect bounds = picture->cullRect().roundOut();
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(bounds.width(), bounds.height());
+
+  Profile profile;
+  profile.cold_ms = 0;
+  std::vector<Op>& ops = profile.ops;
+  SkGraphics::PurgeFontCache();
+  for (int run = 0; run < repeat; ++run) {
+    SkCanvas canvas(bitmap);
+    canvas.clear(SK_ColorTRANSPARENT);
+    canvas.translate(-bounds.x(), -bounds.y());
+    skia::BenchmarkingCanvas benchmarking_canvas(
+        &canvas, skia::BenchmarkingCanvas::kExpandPictures_Flag);
+    picture->playback(&benchmarking_canvas);
+
+    const base::ListValue& commands = benchmarking_canvas.Commands();
+    if (run == 0) {
+      ops.resize(commands.GetSize());
+      for (size_t i = 0; i < ops.size(); ++i) {
+        const base::DictionaryValue* command = nullptr;
+        if (!commands.GetDictionary(i, &command))
+          continue;
+        command->GetString("cmd_string", &ops[i].name);
+        ops[i].paint = PaintString(*command);
+        ops[i].time_ms = 0;
+      }
+    }
+    // Playback is deterministic, so each run records the same ops.
+    for (size_t i = 0; i < ops.size(); ++i) {
+      ops[i].time_ms += benchmarking_canvas.GetTime(i) / repeat;
+      if (run == 0)
+        profile.cold_ms += benchmarking_canvas.GetTime(i);
+    }
+  }
+  return profile;
+}
+
+typedef std::pair<double, std::string> Entry;
+
+void PrintTop(const char* title, std::vector<Entry>* entries, int top) {
+  std::sort(entries->begin(), entries->end(),
+            [](const Entry& a, const Entry& b) { return a.first > b.first; });
+  printf("  %s:\n", title);
+  for (int i = 0; i < top && i < static_cast<int>(entries->size()); ++i)
+    printf("    %9.3f ms  %s\n", (*entries)[i].first,
+           (*entries)[i].second.c_str());
+}
+
+void Report(const Profile& profile, int top) {
+  const std::vector<Op>& ops = profile.ops;
+  double total_ms = 0;
+  double text_ms = 0;
+  std::vector<Entry> op_entries;
+  std::map<std::string, double> paint_times;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    total_ms += ops[i].time_ms;
+    if (IsTextOp(ops[i]))
+      text_ms += ops[i].time_ms;
+    op_entries.push_back(Entry(ops[i].time_ms, "#" + base::SizeTToString(i) +
+                                                   " " + ops[i].name + " " +
+                                                   ops[i].paint));
+    if (!ops[i].paint.empty())
+      paint_times[ops[i].paint] += ops[i].time_ms;
+  }
+
+  // A save layer costs the ops drawn into it plus its restore, where the layer
+  // is composited.
+  std::vector<Entry> layer_entries;
+  std::vector<size_t> saves;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i].name == "Save" || ops[i].name == "SaveLayer") {
+      saves.push_back(i);
+    } else if (ops[i].name == "Restore" && !saves.empty()) {
+      size_t save = saves.back();
+      saves.pop_back();
+      if (ops[save].name != "SaveLayer")
+        continue;
+      double layer_ms = 0;
+      for (size_t j = save; j <= i; ++j)
+        layer_ms += ops[j].time_ms;
+      layer_entries.push_back(Entry(
+          layer_ms, "#" + base::SizeTToString(save) + "-#" +
+                        base::SizeTToString(i) + " " + ops[save].paint));
+    }
+  }
+
+  std::vector<Entry> paint_entries;
+  for (const auto& paint_time : paint_times)
+    paint_entries.push_back(Entry(paint_time.second, paint_time.first));
+
+  printf("  %zu ops, %.3f ms (%.3f ms with an empty glyph cache)\n",
+         ops.size(), total_ms, profile.cold_ms);
+  printf("  Text ops: %.3f ms, glyph cache: %d glyphs, %zu bytes\n", text_ms,
+         SkGraphics::GetFontCacheCountUsed(), SkGraphics::GetFontCacheUsed());
+  PrintTop("Most expensive ops", &op_entries, top);
+  PrintTop("Most expensive save layers", &layer_entries, top);
+  PrintTop("Most expensive paints", &paint_entries, top);
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  base::AtExitManager exit_manager;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  int repeat = kDefaultRepeat;
+  int top = kDefaultTop;
+  if ((command_line.HasSwitch(kRepeat) &&
+       !base::StringToInt(command_line.GetSwitchValueASCII(kRepeat),
+                          &repeat)) ||
+      (command_line.HasSwitch(kTop) &&
+       !base::StringToInt(command_line.GetSwitchValueASCII(kTop), &top)) ||
+      repeat < 1 ||
+      (command_line.GetArgs().empty() &&
+       !command_line.HasSwitch(kParagraphs))) {
+    Usage();
+    return 1;
+  }
+
+  int result = 0;
+  if (command_line.HasSwitch(kParagraphs)) {
+    printf("paragraphs:\n");
+    Report(Run(RecordParagraphFrame().get(), repeat), top);
+  }
+  for (const auto& arg : command_line.GetArgs()) {
+    std::string path = base::FilePath(arg).AsUTF8Unsafe();
+    SkFILEStream stream(path.c_str());
+    skia::RefPtr<SkPicture> picture;
+    if (stream.isValid())
+      picture = skia::AdoptRef(SkPicture::CreateFromStream(&stream,
+                                                           &DecodeBitmap));
+    if (!picture) {
+      fprintf(stderr, "Failed to read %s\n", path.c_str());
+      result = 1;
+      continue;
+    }
+
+    printf("%s:\n", path.c_str());
+    Report(Run(picture.get(), repeat), top);
+  }
+  return result;
+}